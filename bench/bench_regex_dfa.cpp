@@ -0,0 +1,376 @@
+#include "harness.hpp"
+
+#include "falcon/regex_dfa/scan.hpp"
+#include "falcon/regex_dfa/match.hpp"
+#include "falcon/regex_dfa/flat_ranges.hpp"
+#include "falcon/regex_dfa/generate.hpp"
+#include "falcon/regex_dfa/regex.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <regex>
+#include <cstring>
+#include <cstdlib>
+
+namespace re = falcon::regex_dfa;
+
+namespace {
+
+using Inputs = std::vector<std::string>;
+
+struct Case
+{
+  char const * name;
+  char const * pattern;
+  /// strings of about size bytes in total
+  Inputs (*inputs)(std::size_t size);
+};
+
+std::string random_string(std::mt19937 & gen, std::size_t n, char const * alphabet)
+{
+  std::uniform_int_distribution<std::size_t> dist(0, std::strlen(alphabet) - 1u);
+  std::string s(n, '\0');
+  for (auto & c : s) {
+    c = alphabet[dist(gen)];
+  }
+  return s;
+}
+
+/// copies of s
+Inputs repeat(std::string const & s, std::size_t size)
+{
+  return Inputs(std::max<std::size_t>(size / s.size(), 1u), s);
+}
+
+Case const corpus[] {
+  {"literal", "GET /index\\.html", [](std::size_t size) {
+    return repeat("GET /index.html", size);
+  }},
+  {"class", "[a-z0-9_]+", [](std::size_t size) {
+    std::mt19937 gen(1);
+    return Inputs{random_string(gen, size, "abcdefghijklmnopqrstuvwxyz0123456789_")};
+  }},
+  {"alternation", "(GET|POST|PUT|DELETE) /[a-z/]*", [](std::size_t size) {
+    std::mt19937 gen(2);
+    char const * methods[] {"GET", "POST", "PUT", "DELETE"};
+    Inputs inputs;
+    for (std::size_t n = 0; n < size; n += inputs.back().size()) {
+      inputs.push_back(std::string(methods[gen() % 4]) + " /" + random_string(gen, 20, "abcdefgh/"));
+    }
+    return inputs;
+  }},
+  {"bounded", "[0-9]{4}-[0-9]{2}-[0-9]{2}", [](std::size_t size) {
+    std::mt19937 gen(3);
+    Inputs inputs;
+    for (std::size_t n = 0; n < size; n += inputs.back().size()) {
+      inputs.push_back(
+        random_string(gen, 4, "0123456789") + "-"
+        + random_string(gen, 2, "0123456789") + "-"
+        + random_string(gen, 2, "0123456789"));
+    }
+    return inputs;
+  }},
+  {"anchors", "^[a-z]+@[a-z]+\\.com$", [](std::size_t size) {
+    std::mt19937 gen(4);
+    Inputs inputs;
+    for (std::size_t n = 0; n < size; n += inputs.back().size()) {
+      inputs.push_back(random_string(gen, 12, "abcdefghijklmnop") + "@" + random_string(gen, 8, "xyz") + ".com");
+    }
+    return inputs;
+  }},
+  {"skip", "\"[^\"]*\"", [](std::size_t size) {
+    std::mt19937 gen(5);
+    return Inputs{"\"" + random_string(gen, size, "abcdefghijklmnopqrstuvwxyz ,.;") + "\""};
+  }},
+  {"nfa", "[a-c]*a[a-c]{3}", [](std::size_t size) {
+    std::mt19937 gen(6);
+    return Inputs{random_string(gen, size, "abc")};
+  }},
+};
+
+/// inputs cut in strings of max_length bytes at most
+/// (the recursion of std::regex_match overflows the stack on long strings)
+Inputs split(Inputs const & inputs, std::size_t max_length)
+{
+  Inputs r;
+  for (auto & s : inputs) {
+    for (std::size_t i = 0; i < s.size() || (!i && s.empty()); i += max_length) {
+      r.push_back(s.substr(i, max_length));
+    }
+  }
+  return r;
+}
+
+struct Comparison
+{
+  char const * name;
+  double compile_speedup;
+  double match_speedup;
+  std::size_t nb_checks;
+  std::vector<std::pair<std::string, bool>> disagreements;
+};
+
+void write_comparisons(std::ostream & out, std::vector<Comparison> const & comparisons)
+{
+  out
+    << "\n# std::regex (ECMAScript, regex_match) / regex_dfa\n"
+    << std::left << std::setw(14) << "# name"
+    << std::right
+    << std::setw(16) << "scan speedup"
+    << std::setw(16) << "match speedup"
+    << std::setw(16) << "disagreements"
+    << "\n";
+  for (auto & c : comparisons) {
+    out
+      << std::left << "# " << std::setw(12) << c.name
+      << std::right << std::fixed << std::setprecision(2)
+      << std::setw(16) << c.compile_speedup
+      << std::setw(16) << c.match_speedup
+      << std::setw(16) << (std::to_string(c.disagreements.size()) + "/" + std::to_string(c.nb_checks))
+      << "\n";
+    std::size_t n = 0;
+    for (auto & d : c.disagreements) {
+      if (++n > 3) {
+        break;
+      }
+      out << "#   regex_dfa: " << d.second << " std::regex: " << !d.second << " -- \"" << d.first << "\"\n";
+    }
+  }
+}
+
+void usage(char const * name)
+{
+  std::cerr
+    << "usage: " << name << " [--csv | --json] [-w warmup] [-r repetitions]"
+       " [-s input_size] [-f name_filter] [--perf] [--std-regex]\n"
+       "  --perf: hardware counters by byte (Linux perf_event_open)\n"
+       "  --std-regex: comparison with std::regex on inputs cut in 1024 bytes\n";
+}
+
+void write_text(std::ostream & out, std::vector<bench::Result> const & results)
+{
+  bool has_counts[bench::PerfCounters::NbEvents] {};
+  for (auto & r : results) {
+    for (int i = 0; i < bench::PerfCounters::NbEvents; ++i) {
+      has_counts[i] = has_counts[i] || r.time.has_counts[i];
+    }
+  }
+
+  out
+    << std::left << std::setw(14) << "name"
+    << std::setw(24) << "bench"
+    << std::right
+    << std::setw(14) << "median_ns"
+    << std::setw(14) << "p99_ns"
+    << std::setw(12) << "bytes"
+    << std::setw(10) << "MB/s"
+  ;
+  for (int i = 0; i < bench::PerfCounters::NbEvents; ++i) {
+    if (has_counts[i]) {
+      out << std::setw(16) << std::string(bench::PerfCounters::names[i]) + "/B";
+    }
+  }
+  out << "\n";
+  for (auto & r : results) {
+    out
+      << std::left << std::setw(14) << r.name
+      << std::setw(24) << r.bench
+      << std::right << std::fixed << std::setprecision(0)
+      << std::setw(14) << r.time.median
+      << std::setw(14) << r.time.p99
+      << std::setw(12) << r.bytes
+      << std::setprecision(1)
+      << std::setw(10) << r.mb_per_s()
+      << std::setprecision(3)
+    ;
+    for (int i = 0; i < bench::PerfCounters::NbEvents; ++i) {
+      if (has_counts[i]) {
+        out << std::setw(16);
+        if (r.time.has_counts[i]) {
+          out << r.per_byte(i);
+        }
+        else {
+          out << "-";
+        }
+      }
+    }
+    out << "\n";
+  }
+}
+
+}
+
+int main(int ac, char ** av)
+{
+  bench::Options opt;
+  std::size_t input_size = 1 << 20;
+  char const * filter = "";
+  enum { Text, Csv, Json } format = Text;
+  bool use_counters = false;
+  bool compare_std_regex = false;
+
+  for (int i = 1; i < ac; ++i) {
+    auto arg = [&]{
+      if (i + 1 == ac) {
+        usage(av[0]);
+        std::exit(1);
+      }
+      return av[++i];
+    };
+    if (!std::strcmp(av[i], "--csv")) format = Csv;
+    else if (!std::strcmp(av[i], "--json")) format = Json;
+    else if (!std::strcmp(av[i], "-w")) opt.warmup = unsigned(std::atoi(arg()));
+    else if (!std::strcmp(av[i], "-r")) opt.repetitions = unsigned(std::atoi(arg()));
+    else if (!std::strcmp(av[i], "-s")) input_size = std::size_t(std::atoll(arg()));
+    else if (!std::strcmp(av[i], "-f")) filter = arg();
+    else if (!std::strcmp(av[i], "--perf")) use_counters = true;
+    else if (!std::strcmp(av[i], "--std-regex")) compare_std_regex = true;
+    else {
+      usage(av[0]);
+      return 1;
+    }
+  }
+
+  bench::PerfCounters counters;
+  if (use_counters) {
+    if (counters.available()) {
+      opt.counters = &counters;
+    }
+    else {
+      std::cerr << "# hardware counters unavailable (see /proc/sys/kernel/perf_event_paranoid), wall-clock only\n";
+    }
+  }
+
+  std::vector<bench::Result> results;
+  std::vector<Comparison> comparisons;
+
+  for (auto & c : corpus) {
+    if (!std::strstr(c.name, filter)) {
+      continue;
+    }
+
+    re::Ranges rngs;
+    auto const scan_time = bench::measure(opt, [&]{
+      rngs = re::scan(c.pattern);
+      bench::do_not_optimize(rngs);
+    });
+    results.push_back({c.name, c.pattern, "scan", scan_time, re::serialize(rngs).size()});
+
+    auto bench_matcher = [&](
+      char const * bench, Inputs const & inputs,
+      bool (*f)(re::Ranges const &, char const *)
+    ) {
+      std::size_t bytes = 0;
+      for (auto & s : inputs) {
+        bytes += s.size();
+      }
+      auto const time = bench::measure(opt, [&]{
+        for (auto & s : inputs) {
+          bool const r = f(rngs, s.c_str());
+          bench::do_not_optimize(r);
+        }
+      });
+      results.push_back({c.name, c.pattern, bench, time, bytes});
+    };
+
+    auto const inputs = c.inputs(input_size);
+    if (rngs.is_deterministic) {
+      bench_matcher("match", inputs, re::match);
+    }
+    bench_matcher("nfa_match", inputs, re::nfa_match);
+
+    {
+      re::Regex const regex(c.pattern);
+      std::size_t bytes = 0;
+      for (auto & s : inputs) {
+        bytes += s.size();
+      }
+      auto const time = bench::measure(opt, [&]{
+        for (auto & s : inputs) {
+          bool const r = regex(s);
+          bench::do_not_optimize(r);
+        }
+      });
+      results.push_back({c.name, c.pattern, std::string("regex_") + re::to_string(regex.engine()), time, bytes});
+    }
+
+    // worst case of the active set (see re_generate -m adversarial)
+    if (!rngs.is_deterministic) {
+      Inputs adversarial(1);
+      re::Generator(rngs, 0).adversarial(adversarial[0], input_size);
+      bench_matcher("nfa_match_adversarial", adversarial, re::nfa_match);
+    }
+
+    if (compare_std_regex) {
+      std::regex std_re;
+      try {
+        std_re = std::regex(c.pattern, std::regex::ECMAScript);
+      }
+      catch (std::regex_error const & e) {
+        std::cerr << "# " << c.name << ": std::regex: " << e.what() << "\n";
+        continue;
+      }
+
+      auto const std_compile_time = bench::measure(opt, [&]{
+        std::regex r(c.pattern, std::regex::ECMAScript);
+        bench::do_not_optimize(r);
+      });
+      results.push_back({c.name, c.pattern, "std_regex_compile", std_compile_time, 0});
+
+      auto const short_inputs = split(inputs, 1024);
+      bench_matcher("matches_split", short_inputs, re::matches);
+      auto const matches_time = results.back().time;
+      std::size_t bytes = 0;
+      for (auto & s : short_inputs) {
+        bytes += s.size();
+      }
+      auto const std_match_time = bench::measure(opt, [&]{
+        for (auto & s : short_inputs) {
+          bool const r = std::regex_match(s, std_re);
+          bench::do_not_optimize(r);
+        }
+      });
+      results.push_back({c.name, c.pattern, "std_regex_match", std_match_time, bytes});
+
+      // same results on the inputs and on generated strings
+      Comparison comparison {
+        c.name,
+        std_compile_time.median / scan_time.median,
+        std_match_time.median / matches_time.median,
+        0, {}
+      };
+      auto check = [&](std::string const & s) {
+        bool const r = re::matches(rngs, s.c_str());
+        ++comparison.nb_checks;
+        if (r != std::regex_match(s, std_re)) {
+          comparison.disagreements.emplace_back(s, r);
+        }
+      };
+      for (auto & s : short_inputs) {
+        check(s);
+      }
+      re::Generator generator(rngs, 1);
+      std::string s;
+      for (int i = 0; i < 100; ++i) {
+        if (generator.matching(s, 16)) {
+          check(s);
+        }
+        if (generator.near_miss(s, 16)) {
+          check(s);
+        }
+      }
+      comparisons.push_back(std::move(comparison));
+    }
+  }
+
+  switch (format) {
+    case Text: write_text(std::cout, results); break;
+    case Csv: bench::write_csv(std::cout, results); break;
+    case Json: bench::write_json(std::cout, results); break;
+  }
+  if (compare_std_regex) {
+    write_comparisons(format == Text ? std::cout : std::cerr, comparisons);
+  }
+  return 0;
+}
@@ -0,0 +1,215 @@
+#ifndef FALCON_REGEX_DFA_BENCH_HARNESS_HPP
+#define FALCON_REGEX_DFA_BENCH_HARNESS_HPP
+
+#include "perf_counters.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ostream>
+#include <string>
+#include <vector>
+
+
+namespace bench {
+
+struct Options
+{
+  unsigned warmup = 3;
+  unsigned repetitions = 21;
+  /// read around each repetition when not null
+  PerfCounters * counters = nullptr;
+};
+
+/// in nanoseconds
+struct Summary
+{
+  double min;
+  double median;
+  double p99;
+  unsigned repetitions;
+  /// mean by repetition of the hardware counters
+  double counts[PerfCounters::NbEvents];
+  bool has_counts[PerfCounters::NbEvents];
+};
+
+/// keep x and the computations of x
+template<class T>
+inline void do_not_optimize(T const & x)
+{
+  asm volatile("" : : "g"(&x) : "memory");
+}
+
+inline Summary summarize(std::vector<double> samples)
+{
+  std::sort(samples.begin(), samples.end());
+  auto const n = samples.size();
+  auto const p99 = std::size_t(std::ceil(double(n) * 0.99));
+  return {
+    samples.front(),
+    n % 2 ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2,
+    samples[std::max<std::size_t>(p99, 1) - 1],
+    unsigned(n),
+    {},
+    {},
+  };
+}
+
+/// f() is run opt.warmup times, then timed opt.repetitions times
+template<class F>
+Summary measure(Options const & opt, F && f)
+{
+  using clock = std::chrono::steady_clock;
+
+  for (unsigned i = 0; i < opt.warmup; ++i) {
+    f();
+  }
+
+  std::vector<double> samples;
+  samples.reserve(std::max(opt.repetitions, 1u));
+  double counts[PerfCounters::NbEvents] {};
+  unsigned nb_counts[PerfCounters::NbEvents] {};
+  do {
+    if (opt.counters) {
+      opt.counters->start();
+    }
+    auto const t0 = clock::now();
+    f();
+    auto const t1 = clock::now();
+    if (opt.counters) {
+      auto const values = opt.counters->stop();
+      for (int i = 0; i < PerfCounters::NbEvents; ++i) {
+        if (values.valid[i]) {
+          counts[i] += double(values.values[i]);
+          ++nb_counts[i];
+        }
+      }
+    }
+    samples.push_back(std::chrono::duration<double, std::nano>(t1 - t0).count());
+  } while (samples.size() < opt.repetitions);
+
+  auto summary = summarize(std::move(samples));
+  for (int i = 0; i < PerfCounters::NbEvents; ++i) {
+    summary.has_counts[i] = nb_counts[i];
+    summary.counts[i] = nb_counts[i] ? counts[i] / nb_counts[i] : 0;
+  }
+  return summary;
+}
+
+struct Result
+{
+  std::string name;
+  std::string pattern;
+  std::string bench;
+  Summary time;
+  /// input size for a matcher, image size for a compilation
+  std::size_t bytes;
+
+  bool is_compilation() const
+  {
+    return bench == "scan" || bench == "std_regex_compile";
+  }
+
+  /// 0 for a compilation
+  double mb_per_s() const
+  {
+    return is_compilation() || time.median <= 0 ? 0 : double(bytes) / time.median * 1e3;
+  }
+
+  /// hardware counter by input byte (by compilation for scan)
+  double per_byte(int event) const
+  {
+    return is_compilation() || !bytes ? time.counts[event] : time.counts[event] / double(bytes);
+  }
+};
+
+inline void write_json_string(std::ostream & out, std::string const & s)
+{
+  out << '"';
+  for (unsigned char c : s) {
+    if (c == '"' || c == '\\') {
+      out << '\\' << char(c);
+    }
+    else if (c < 0x20) {
+      constexpr char hex[] = "0123456789abcdef";
+      out << "\\u00" << hex[c >> 4] << hex[c & 0xf];
+    }
+    else {
+      out << char(c);
+    }
+  }
+  out << '"';
+}
+
+inline void write_csv_string(std::ostream & out, std::string const & s)
+{
+  out << '"';
+  for (char c : s) {
+    if (c == '"') {
+      out << '"';
+    }
+    out << c;
+  }
+  out << '"';
+}
+
+inline void write_csv(std::ostream & out, std::vector<Result> const & results)
+{
+  out << "name,pattern,bench,repetitions,min_ns,median_ns,p99_ns,bytes,mb_per_s";
+  for (auto name : PerfCounters::names) {
+    out << ',' << name << "_per_byte";
+  }
+  out << '\n';
+  for (auto & r : results) {
+    write_csv_string(out, r.name);
+    out << ',';
+    write_csv_string(out, r.pattern);
+    out
+      << ',' << r.bench
+      << ',' << r.time.repetitions
+      << ',' << r.time.min
+      << ',' << r.time.median
+      << ',' << r.time.p99
+      << ',' << r.bytes
+      << ',' << r.mb_per_s();
+    for (int i = 0; i < PerfCounters::NbEvents; ++i) {
+      out << ',';
+      if (r.time.has_counts[i]) {
+        out << r.per_byte(i);
+      }
+    }
+    out << '\n';
+  }
+}
+
+inline void write_json(std::ostream & out, std::vector<Result> const & results)
+{
+  out << "[\n";
+  char const * sep = "";
+  for (auto & r : results) {
+    out << sep << "  {\"name\": ";
+    write_json_string(out, r.name);
+    out << ", \"pattern\": ";
+    write_json_string(out, r.pattern);
+    out
+      << ", \"bench\": \"" << r.bench << '"'
+      << ", \"repetitions\": " << r.time.repetitions
+      << ", \"min_ns\": " << r.time.min
+      << ", \"median_ns\": " << r.time.median
+      << ", \"p99_ns\": " << r.time.p99
+      << ", \"bytes\": " << r.bytes
+      << ", \"mb_per_s\": " << r.mb_per_s();
+    for (int i = 0; i < PerfCounters::NbEvents; ++i) {
+      if (r.time.has_counts[i]) {
+        out << ", \"" << PerfCounters::names[i] << "_per_byte\": " << r.per_byte(i);
+      }
+    }
+    out << "}";
+    sep = ",\n";
+  }
+  out << "\n]\n";
+}
+
+}
+
+#endif
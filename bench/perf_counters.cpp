@@ -0,0 +1,121 @@
+#include "perf_counters.hpp"
+
+#ifdef __linux__
+# include <linux/perf_event.h>
+# include <sys/ioctl.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+# include <cstring>
+#endif
+
+
+namespace bench {
+
+constexpr char const * PerfCounters::names[];
+
+#ifdef __linux__
+
+namespace {
+
+int open_counter(uint32_t type, uint64_t config)
+{
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  attr.disabled = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  return int(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+constexpr uint64_t cache_miss(uint64_t cache)
+{
+  return cache
+    | (uint64_t{PERF_COUNT_HW_CACHE_OP_READ} << 8)
+    | (uint64_t{PERF_COUNT_HW_CACHE_RESULT_MISS} << 16);
+}
+
+}
+
+PerfCounters::PerfCounters()
+{
+  fds_[Cycles] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+  fds_[Instructions] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+  fds_[BranchMisses] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+  fds_[L1dMisses] = open_counter(PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_L1D));
+  fds_[LlcMisses] = open_counter(PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_LL));
+}
+
+PerfCounters::~PerfCounters()
+{
+  for (int fd : fds_) {
+    if (fd != -1) {
+      ::close(fd);
+    }
+  }
+}
+
+bool PerfCounters::available() const
+{
+  for (int fd : fds_) {
+    if (fd != -1) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void PerfCounters::start()
+{
+  for (int fd : fds_) {
+    if (fd != -1) {
+      ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+      ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+}
+
+PerfCounters::Values PerfCounters::stop()
+{
+  Values r {};
+  for (int fd : fds_) {
+    if (fd != -1) {
+      ::ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+  }
+  for (int i = 0; i < NbEvents; ++i) {
+    r.valid[i] = fds_[i] != -1
+      && ::read(fds_[i], &r.values[i], sizeof(r.values[i])) == sizeof(r.values[i]);
+  }
+  return r;
+}
+
+#else
+
+PerfCounters::PerfCounters()
+{
+  for (int & fd : fds_) {
+    fd = -1;
+  }
+}
+
+PerfCounters::~PerfCounters() = default;
+
+bool PerfCounters::available() const
+{
+  return false;
+}
+
+void PerfCounters::start()
+{}
+
+PerfCounters::Values PerfCounters::stop()
+{
+  return {};
+}
+
+#endif
+
+}
@@ -0,0 +1,48 @@
+#ifndef FALCON_REGEX_DFA_BENCH_PERF_COUNTERS_HPP
+#define FALCON_REGEX_DFA_BENCH_PERF_COUNTERS_HPP
+
+#include <cstdint>
+
+
+namespace bench {
+
+/// Hardware counters of the calling thread with perf_event_open (Linux).
+///
+/// Each counter is opened separately: a counter refused by the system or
+/// the hardware is missing, the others still work. With a restrictive
+/// /proc/sys/kernel/perf_event_paranoid, available() is false.
+class PerfCounters
+{
+public:
+  enum Event { Cycles, Instructions, BranchMisses, L1dMisses, LlcMisses, NbEvents };
+
+  static constexpr char const * names[NbEvents] {
+    "cycles", "instructions", "branch_misses", "l1d_misses", "llc_misses",
+  };
+
+  struct Values
+  {
+    uint64_t values[NbEvents];
+    bool valid[NbEvents];
+  };
+
+  PerfCounters();
+  ~PerfCounters();
+
+  PerfCounters(PerfCounters const &) = delete;
+  PerfCounters & operator = (PerfCounters const &) = delete;
+
+  /// true when at least one counter is open
+  bool available() const;
+
+  void start();
+  /// \return  counts since start()
+  Values stop();
+
+private:
+  int fds_[NbEvents];
+};
+
+}
+
+#endif
@@ -0,0 +1,285 @@
+#include "analysis.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+
+namespace falcon { namespace regex_dfa {
+
+namespace {
+
+bool is_final(Range const & rng)
+{
+  return bool(rng.states & (Range::Final | Range::Eol));
+}
+
+struct Edge
+{
+  Event e;
+  std::size_t next;
+};
+
+/// Ranges with a start node (index rngs.size()) for the first character:
+/// its edges are the Normal and Bol transitions of the first range,
+/// the other nodes only have Normal transitions.
+struct Graph
+{
+  std::vector<std::vector<Edge>> edges;
+  std::vector<char> finals;
+  std::size_t start;
+
+  explicit Graph(Ranges const & rngs)
+  : edges(rngs.size() + 1)
+  , finals(rngs.size() + 1)
+  , start(rngs.size())
+  {
+    for (std::size_t i = 0; i < rngs.size(); ++i) {
+      finals[i] = is_final(rngs[i]);
+      for (auto & t : rngs[i].transitions) {
+        if (t.states & Transition::Normal) {
+          edges[i].push_back({t.e, t.next});
+        }
+        if (i == 0 && (t.states & (Transition::Normal | Transition::Bol))) {
+          edges[start].push_back({t.e, t.next});
+        }
+      }
+    }
+    finals[start] = !rngs.empty() && finals[0];
+  }
+};
+
+struct LengthBounds
+{
+  std::size_t min;
+  std::size_t max;
+};
+
+/// shortest and longest path from the start to a final node,
+/// weight(e, false) and weight(e, true) are the minimal and maximal
+/// lengths of a character of e
+LengthBounds length_bounds(
+  Graph const & g, std::function<std::size_t(Event const &, bool)> const & weight)
+{
+  auto const n = g.edges.size();
+
+  // Dijkstra
+  std::vector<std::size_t> dist(n, infinite_length);
+  using Item = std::pair<std::size_t, std::size_t>;
+  std::priority_queue<Item, std::vector<Item>, std::greater<Item>> queue;
+  dist[g.start] = 0;
+  queue.push({0, g.start});
+  std::size_t min = infinite_length;
+  while (!queue.empty()) {
+    auto const d = queue.top().first;
+    auto const i = queue.top().second;
+    queue.pop();
+    if (d != dist[i]) {
+      continue;
+    }
+    if (g.finals[i]) {
+      min = std::min(min, d);
+    }
+    for (auto & edge : g.edges[i]) {
+      auto const nd = d + weight(edge.e, false);
+      if (nd < dist[edge.next]) {
+        dist[edge.next] = nd;
+        queue.push({nd, edge.next});
+      }
+    }
+  }
+  if (min == infinite_length) {
+    return {infinite_length, 0};
+  }
+
+  // nodes on a path from the start to a final node
+  std::vector<std::vector<std::size_t>> previous(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    for (auto & edge : g.edges[i]) {
+      previous[edge.next].push_back(i);
+    }
+  }
+  std::vector<char> useful(n);
+  std::vector<std::size_t> stack;
+  for (std::size_t i = 0; i < n; ++i) {
+    if (g.finals[i] && dist[i] != infinite_length) {
+      useful[i] = 1;
+      stack.push_back(i);
+    }
+  }
+  while (!stack.empty()) {
+    auto const i = stack.back();
+    stack.pop_back();
+    for (auto p : previous[i]) {
+      if (!useful[p] && dist[p] != infinite_length) {
+        useful[p] = 1;
+        stack.push_back(p);
+      }
+    }
+  }
+
+  // longest path with a depth first search, a cycle is infinite
+  enum : char { White, Grey, Black };
+  std::vector<char> colors(n, White);
+  std::vector<std::size_t> longest(n, 0);
+  bool has_cycle = false;
+  std::function<void(std::size_t)> visit = [&](std::size_t i) {
+    colors[i] = Grey;
+    std::size_t best = g.finals[i] ? 0 : infinite_length;
+    for (auto & edge : g.edges[i]) {
+      if (!useful[edge.next] || has_cycle) {
+        continue;
+      }
+      if (colors[edge.next] == Grey) {
+        has_cycle = true;
+        return;
+      }
+      if (colors[edge.next] == White) {
+        visit(edge.next);
+      }
+      if (longest[edge.next] != infinite_length) {
+        auto const l = longest[edge.next] + weight(edge.e, true);
+        best = best == infinite_length ? l : std::max(best, l);
+      }
+    }
+    longest[i] = best;
+    colors[i] = Black;
+  };
+  visit(g.start);
+
+  return {min, has_cycle ? infinite_length : longest[g.start]};
+}
+
+/// number of bytes of a packed UTF-8 character
+std::size_t nb_bytes(char_int c)
+{
+  return c >> 24 ? 4 : c >> 16 ? 3 : c >> 8 ? 2 : 1;
+}
+
+/// bytes of a packed UTF-8 character
+void append_bytes(std::string & s, char_int c)
+{
+  for (int shift = 24; shift >= 0; shift -= 8) {
+    if (auto const byte = char(c >> shift)) {
+      s += byte;
+    }
+  }
+}
+
+bool literal(Graph const & g, std::string & s)
+{
+  s.clear();
+  std::size_t i = g.start;
+  std::vector<char> visited(g.edges.size());
+  for (;;) {
+    auto const & edges = g.edges[i];
+    if (edges.empty()) {
+      return g.finals[i];
+    }
+    if (g.finals[i] || edges.size() != 1 || !edges[0].e.is_char() || visited[i]) {
+      return false;
+    }
+    visited[i] = 1;
+    append_bytes(s, edges[0].e.l);
+    i = edges[0].next;
+  }
+}
+
+/// every string from i to a final node of an acyclic graph
+/// \return  false when the set is too large
+bool literals(
+  Graph const & g, std::size_t i, std::string & s,
+  std::vector<std::string> & strings, std::size_t & budget
+) {
+  if (g.finals[i]) {
+    if (strings.size() == max_literals) {
+      return false;
+    }
+    strings.push_back(s);
+  }
+  auto const size = s.size();
+  for (auto & edge : g.edges[i]) {
+    auto const & e = edge.e;
+    if (!e.is_char() && (e.r >= 0x80 || e.r - e.l >= 16)) {
+      return false;
+    }
+    for (char_int c = std::max(e.l, char_int{1}); c <= e.r; ++c) {
+      if (!budget--) {
+        return false;
+      }
+      append_bytes(s, c);
+      if (!literals(g, edge.next, s, strings, budget)) {
+        return false;
+      }
+      s.resize(size);
+    }
+  }
+  return true;
+}
+
+}
+
+Analysis analyze(const Ranges& rngs)
+{
+  Analysis a {};
+  a.nb_states = rngs.size();
+  for (auto & rng : rngs) {
+    a.nb_transitions += rng.transitions.size();
+  }
+  a.is_deterministic = rngs.is_deterministic;
+
+  a.is_anchored_begin = !rngs.empty() && !rngs[0].transitions.empty()
+    && std::all_of(rngs[0].transitions.begin(), rngs[0].transitions.end(), [](Transition const & t) {
+      return t.states == Transition::Bol;
+    });
+
+  bool has_final = false;
+  a.is_anchored_end = true;
+  for (auto & rng : rngs) {
+    if (is_final(rng)) {
+      has_final = true;
+      a.is_anchored_end = a.is_anchored_end && (rng.states & Range::Eol);
+    }
+  }
+  a.is_anchored_end = a.is_anchored_end && has_final;
+
+  Graph const g(rngs);
+  a.is_literal = !rngs.empty() && literal(g, a.literal);
+  if (!a.is_literal) {
+    a.literal.clear();
+  }
+
+  auto const bounds = length_bounds(g, [](Event const &, bool) { return std::size_t{1}; });
+  a.min_length = bounds.min;
+  a.max_length = bounds.max;
+
+  // packed characters are ordered by size, the bytes of an event are
+  // between those of its bounds
+  auto const bytes = length_bounds(g, [](Event const & e, bool is_max) {
+    return nb_bytes(is_max ? e.r : e.l);
+  });
+  a.min_bytes = bytes.min;
+  a.max_bytes = bytes.max;
+
+  if (!rngs.empty() && a.max_length != infinite_length) {
+    std::string s;
+    // paths of a non deterministic automaton can give the same string
+    std::size_t budget = max_literals * 16;
+    if (literals(g, g.start, s, a.literals, budget)) {
+      std::sort(a.literals.begin(), a.literals.end());
+      a.literals.erase(std::unique(a.literals.begin(), a.literals.end()), a.literals.end());
+    }
+    else {
+      a.literals.clear();
+    }
+  }
+
+  // see matches()
+  if (rngs.empty()) {
+    a.min_length = a.min_bytes = 0;
+    a.max_length = a.max_bytes = infinite_length;
+  }
+  return a;
+}
+
+} }
@@ -0,0 +1,53 @@
+#ifndef FALCON_REGEX_DFA_ANALYSIS_HPP
+#define FALCON_REGEX_DFA_ANALYSIS_HPP
+
+#include "redfa.hpp"
+
+#include <string>
+#include <vector>
+
+
+namespace falcon { namespace regex_dfa {
+
+/// max_length of an automaton with a loop
+constexpr std::size_t infinite_length = ~std::size_t{};
+
+/// max size of Analysis::literals
+constexpr std::size_t max_literals = 256;
+
+/// Facts on an automaton, computed by analyze().
+struct Analysis
+{
+  std::size_t nb_states;
+  std::size_t nb_transitions;
+  bool is_deterministic;
+  /// every transition of the first range requires the beginning of line
+  bool is_anchored_begin;
+  /// every final range is an end of line
+  bool is_anchored_end;
+  /// only literal is accepted
+  bool is_literal;
+  std::string literal;
+  /// sorted accepted strings when they are at most max_literals and made of
+  /// characters or small ASCII intervals, otherwise empty
+  std::vector<std::string> literals;
+  /// bounds of the number of characters (code points) of the accepted
+  /// strings, min_length is infinite_length when nothing is accepted
+  std::size_t min_length;
+  std::size_t max_length;
+  /// same in bytes of UTF-8
+  std::size_t min_bytes;
+  std::size_t max_bytes;
+};
+
+Analysis analyze(Ranges const & rngs);
+
+/// \return  false when no string of size bytes can be accepted
+inline bool is_accepted_size(Analysis const & a, std::size_t size)
+{
+  return a.min_bytes <= size && size <= a.max_bytes;
+}
+
+} }
+
+#endif
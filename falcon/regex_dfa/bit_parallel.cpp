@@ -0,0 +1,131 @@
+#include "bit_parallel.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+
+namespace falcon { namespace regex_dfa {
+
+namespace {
+
+constexpr std::size_t chunk_bits = 4;
+constexpr std::size_t chunk_size = 1u << chunk_bits;
+
+std::vector<char_int> class_bounds(Ranges const & rngs)
+{
+  std::vector<char_int> bounds {0};
+  for (auto & rng : rngs) {
+    for (auto & t : rng.transitions) {
+      bounds.push_back(t.e.l);
+      if (t.e.r != ~char_int{}) {
+        bounds.push_back(t.e.r + 1);
+      }
+    }
+  }
+  std::sort(bounds.begin(), bounds.end());
+  bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+  return bounds;
+}
+
+std::size_t nb_chunks(Ranges const & rngs)
+{
+  return (rngs.size() + chunk_bits - 1) / chunk_bits;
+}
+
+}
+
+std::size_t BitParallelMatcher::tables_size(const Ranges& rngs)
+{
+  return class_bounds(rngs).size() * (nb_chunks(rngs) * chunk_size + 1) * sizeof(uint64_t);
+}
+
+BitParallelMatcher::BitParallelMatcher(const Ranges& rngs)
+: bounds_(class_bounds(rngs))
+, nb_chunks_(nb_chunks(rngs))
+, accept_all_(rngs.empty())
+{
+  if (rngs.size() > max_states) {
+    throw std::runtime_error("too many states for BitParallelMatcher");
+  }
+
+  for (char_int c = 0; c < 128; ++c) {
+    ascii_classes_[c] = uint16_t(std::upper_bound(bounds_.begin(), bounds_.end(), c) - bounds_.begin() - 1);
+  }
+
+  auto const nb_classes = bounds_.size();
+  tables_.resize(nb_classes * nb_chunks_ * chunk_size);
+  first_.resize(nb_classes);
+
+  std::vector<uint64_t> nexts(rngs.size());
+  for (std::size_t k = 0; k < nb_classes; ++k) {
+    // all the characters of a class have the transitions of the first one
+    char_int const c = bounds_[k];
+    for (std::size_t i = 0; i < rngs.size(); ++i) {
+      nexts[i] = 0;
+      for (auto & t : rngs[i].transitions) {
+        if (t.e.contains(c)) {
+          if (t.states & Transition::Normal) {
+            nexts[i] |= uint64_t{1} << t.next;
+          }
+          if (i == 0 && (t.states & (Transition::Normal | Transition::Bol))) {
+            first_[k] |= uint64_t{1} << t.next;
+          }
+        }
+      }
+    }
+
+    uint64_t * table = &tables_[k * nb_chunks_ * chunk_size];
+    for (std::size_t j = 0; j < nb_chunks_; ++j) {
+      for (std::size_t v = 0; v < chunk_size; ++v) {
+        uint64_t mask = 0;
+        for (std::size_t b = 0; b < chunk_bits; ++b) {
+          auto const i = j * chunk_bits + b;
+          if ((v >> b) & 1u && i < rngs.size()) {
+            mask |= nexts[i];
+          }
+        }
+        table[j * chunk_size + v] = mask;
+      }
+    }
+  }
+
+  for (std::size_t i = 0; i < rngs.size(); ++i) {
+    if (rngs[i].states & (Range::Final | Range::Eol)) {
+      finals_ |= uint64_t{1} << i;
+    }
+  }
+}
+
+std::size_t BitParallelMatcher::char_class(char_int c) const
+{
+  if (c < 128) {
+    return ascii_classes_[c];
+  }
+  return std::size_t(std::upper_bound(bounds_.begin(), bounds_.end(), c) - bounds_.begin() - 1);
+}
+
+bool BitParallelMatcher::operator()(const char* s) const
+{
+  if (accept_all_) {
+    return true;
+  }
+
+  utf8_consumer consumer(s);
+  char_int c = consumer.bumpc();
+  if (!c) {
+    return finals_ & 1u;
+  }
+
+  uint64_t active = first_[char_class(c)];
+  while (active && (c = consumer.bumpc())) {
+    uint64_t const * table = &tables_[char_class(c) * nb_chunks_ * chunk_size];
+    uint64_t next = 0;
+    for (std::size_t j = 0; j < nb_chunks_; ++j, active >>= chunk_bits) {
+      next |= table[j * chunk_size + (active & (chunk_size - 1))];
+    }
+    active = next;
+  }
+  return !c && (active & finals_);
+}
+
+} }
@@ -0,0 +1,50 @@
+#ifndef FALCON_REGEX_DFA_BIT_PARALLEL_HPP
+#define FALCON_REGEX_DFA_BIT_PARALLEL_HPP
+
+#include "redfa.hpp"
+
+#include <cstdint>
+
+
+namespace falcon { namespace regex_dfa {
+
+/// nfa_match() with the set of active ranges in a 64 bits word.
+///
+/// The characters are grouped in classes with the same transitions, and
+/// the next set is read by groups of 4 active ranges in tables indexed by
+/// class, so a character costs nb_states / 4 lookups whatever the number
+/// of active ranges.
+class BitParallelMatcher
+{
+public:
+  static constexpr std::size_t max_states = 64;
+
+  BitParallelMatcher() = default;
+
+  /// \pre  rngs.size() <= max_states
+  explicit BitParallelMatcher(Ranges const & rngs);
+
+  /// semantics of matches()
+  bool operator()(char const * s) const;
+
+  /// \return  bytes of the tables that would be built for rngs
+  static std::size_t tables_size(Ranges const & rngs);
+
+private:
+  std::size_t char_class(char_int c) const;
+
+  /// first character of each class
+  std::vector<char_int> bounds_;
+  uint16_t ascii_classes_[128] {};
+  std::size_t nb_chunks_ = 0;
+  /// [class][chunk][4 bits of active ranges]
+  std::vector<uint64_t> tables_;
+  /// [class], from the first range with the Bol transitions
+  std::vector<uint64_t> first_;
+  uint64_t finals_ = 0;
+  bool accept_all_ = true;
+};
+
+} }
+
+#endif
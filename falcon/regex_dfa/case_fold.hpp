@@ -0,0 +1,19 @@
+#ifndef FALCON_REGEX_DFA_CASE_FOLD_HPP
+#define FALCON_REGEX_DFA_CASE_FOLD_HPP
+
+#include "redfa.hpp"
+
+namespace falcon { namespace regex_dfa {
+
+/// Add the characters with the same Unicode simple case folding as the
+/// characters of the events of ts (as 'k', 'K' and KELVIN SIGN).
+///
+/// The events of valid characters are replaced by the merged intervals of
+/// the folded code points, one transition by interval and UTF-8 size.
+/// The other events (as the one of '.') are kept.
+/// \pre  the transitions of ts go to next with state
+void fold_case(Transitions & ts, std::size_t next, Transition::State state);
+
+} }
+
+#endif
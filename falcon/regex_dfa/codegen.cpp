@@ -0,0 +1,236 @@
+#include "codegen.hpp"
+#include "static_regex.hpp"
+#include "deterministic.hpp"
+#include "scan.hpp"
+
+#include <algorithm>
+#include <ostream>
+
+
+namespace falcon { namespace regex_dfa {
+
+namespace {
+
+void write_indent(std::ostream & out, unsigned depth)
+{
+  while (depth--) {
+    out << "  ";
+  }
+}
+
+void write_goto(std::ostream & out, std::size_t next)
+{
+  out << "goto r" << next << ";";
+}
+
+using It = Intervals::const_iterator;
+
+/// binary search
+void write_tree(std::ostream & out, It first, It last, unsigned depth)
+{
+  write_indent(out, depth);
+  if (first == last) {
+    out << "return false;\n";
+    return ;
+  }
+
+  if (last - first == 1) {
+    Event const & e = first->e;
+    out << "if (";
+    if (e.is_char()) {
+      out << "c == " << e.l << "u";
+    }
+    else if (!e.l) {
+      out << "c <= " << e.r << "u";
+    }
+    else if (e.r == ~char_int{}) {
+      out << "c >= " << e.l << "u";
+    }
+    else {
+      out << e.l << "u <= c && c <= " << e.r << "u";
+    }
+    out << ") ";
+    write_goto(out, first->next);
+    out << "\n";
+    write_indent(out, depth);
+    out << "return false;\n";
+    return ;
+  }
+
+  auto middle = first + (last - first) / 2;
+  out << "if (c < " << middle->e.l << "u) {\n";
+  write_tree(out, first, middle, depth + 1);
+  write_indent(out, depth);
+  out << "}\n";
+  write_tree(out, middle, last, depth);
+}
+
+/// jump table for a set of characters
+void write_switch(std::ostream & out, It first, It last, unsigned depth)
+{
+  write_indent(out, depth);
+  out << "switch (c) {\n";
+  for (; first != last; ++first) {
+    write_indent(out, depth + 1);
+    out << "case " << first->e.l << "u: ";
+    write_goto(out, first->next);
+    out << "\n";
+  }
+  write_indent(out, depth + 1);
+  out << "default: return false;\n";
+  write_indent(out, depth);
+  out << "}\n";
+}
+
+void write_transitions(std::ostream & out, Intervals const & intervals)
+{
+  constexpr std::size_t min_switch = 4;
+  bool const is_chars = std::all_of(intervals.begin(), intervals.end(), [](Interval const & i) {
+    return i.e.is_char();
+  });
+  if (is_chars && intervals.size() >= min_switch) {
+    write_switch(out, intervals.begin(), intervals.end(), 1);
+  }
+  else {
+    write_tree(out, intervals.begin(), intervals.end(), 1);
+  }
+}
+
+void write_step(std::ostream & out, Range const & rng)
+{
+  out << "  c = utf8_bumpc(s);\n  if (!c) return "
+    << (rng.states & (Range::Final | Range::Eol) ? "true" : "false")
+    << ";\n"
+  ;
+}
+
+/// the result is known in a Range::AcceptAll or a Range::Dead
+bool write_decided(std::ostream & out, Range const & rng)
+{
+  if (rng.hints & Range::AcceptAll) {
+    out << "  return true;\n";
+    return true;
+  }
+  if (rng.hints & Range::Dead) {
+    out << "  return false;\n";
+    return true;
+  }
+  return false;
+}
+
+void write_dfa(std::ostream & out, char const * name, Ranges const & rngs)
+{
+  // s is not read
+  if (rngs.front().hints & (Range::AcceptAll | Range::Dead)) {
+    out << "inline bool " << name << "(char const *)\n{\n";
+    write_decided(out, rngs.front());
+    out << "}\n";
+    return ;
+  }
+
+  Intervals intervals;
+
+  // a label is written when a goto jumps to it: the first character
+  // follows the Normal|Bol transitions of the first range, the others
+  // the Normal transitions of the labels. A decided range has no goto.
+  std::vector<bool> is_target(rngs.size());
+  std::vector<std::size_t> stack;
+  auto add_targets = [&](Range const & rng, Transition::State states) {
+    if (rng.hints & (Range::AcceptAll | Range::Dead)) {
+      return ;
+    }
+    for (auto & t : rng.transitions) {
+      if ((t.states & states) && !is_target[t.next]) {
+        is_target[t.next] = true;
+        stack.push_back(t.next);
+      }
+    }
+  };
+  add_targets(rngs.front(), Transition::Normal | Transition::Bol);
+  while (!stack.empty()) {
+    auto const i = stack.back();
+    stack.pop_back();
+    add_targets(rngs[i], Transition::Normal);
+  }
+
+  out
+    << "inline bool " << name << "(char const * s)\n{\n"
+       "  using falcon::regex_dfa::utf8_bumpc;\n"
+       "  falcon::regex_dfa::char_int c;\n\n"
+  ;
+
+  // first character: Bol transitions of the first range
+  write_step(out, rngs.front());
+  sorted_intervals(intervals, rngs.front(), Transition::Normal | Transition::Bol);
+  write_transitions(out, intervals);
+
+  std::size_t i = 0;
+  for (auto & rng : rngs) {
+    if (is_target[i]) {
+      out << "\nr" << i << ":\n";
+      if (!write_decided(out, rng)) {
+        if (rng.hints & Range::Skip) {
+          out << "  s += std::strcspn(s, \"";
+          for (char const * p = rng.escapes; *p; ++p) {
+            out << '\\' << char('0' + ((*p >> 6) & 7)) << char('0' + ((*p >> 3) & 7)) << char('0' + (*p & 7));
+          }
+          out << "\");\n";
+        }
+        write_step(out, rng);
+        sorted_intervals(intervals, rng, Transition::Normal);
+        write_transitions(out, intervals);
+      }
+    }
+    ++i;
+  }
+
+  out << "}\n";
+}
+
+void write_comment(std::ostream & out, char const * pattern)
+{
+  out << "\n// pattern: ";
+  for (; *pattern; ++pattern) {
+    out << (*pattern == '\n' ? ' ' : *pattern);
+  }
+  // a final backslash would continue the comment on the next line
+  out << " //\n";
+}
+
+}
+
+void write_matcher(std::ostream& out, const char* name, const Ranges& rngs)
+{
+  if (rngs.is_deterministic) {
+    write_dfa(out, name, rngs);
+  }
+  else {
+    std::string const tables = std::string(name) + "_static_regex";
+    write_static_regex(out, tables.c_str(), rngs);
+    out
+      << "inline bool " << name << "(char const * s)\n{\n  return "
+      << tables << ".nfa_match(s);\n}\n"
+    ;
+  }
+}
+
+void write_matchers(
+  std::ostream& out,
+  const char* const* names,
+  const char* const* patterns,
+  std::size_t n
+) {
+  out <<
+    "// generated by re_codegen\n"
+    "#include \"falcon/regex_dfa/static_regex.hpp\"\n"
+    "#include \"falcon/regex_dfa/regex_consumer.hpp\"\n"
+    "\n"
+    "#include <cstring>\n"
+  ;
+  for (std::size_t i = 0; i < n; ++i) {
+    write_comment(out, patterns[i]);
+    write_matcher(out, names[i], scan(patterns[i]));
+  }
+}
+
+} }
@@ -0,0 +1,27 @@
+#ifndef FALCON_REGEX_DFA_CODEGEN_HPP
+#define FALCON_REGEX_DFA_CODEGEN_HPP
+
+#include <iosfwd>
+#include <cstddef>
+
+namespace falcon { namespace regex_dfa {
+
+class Ranges;
+
+/// Write a header with an inline function `bool name(char const *)` for each pattern.
+/// The functions have the semantics of matches().
+/// \throw std::runtime_error
+void write_matchers(
+  std::ostream & out,
+  char const * const * names,
+  char const * const * patterns,
+  std::size_t n
+);
+
+/// Deterministic automata become one label by range and nested comparisons
+/// (or a switch) by transitions, the others use a static_regex.
+void write_matcher(std::ostream & out, char const * name, Ranges const & rngs);
+
+} }
+
+#endif
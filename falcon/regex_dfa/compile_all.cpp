@@ -0,0 +1,78 @@
+#include "compile_all.hpp"
+
+#include <atomic>
+#include <stdexcept>
+#include <system_error>
+#include <algorithm>
+
+
+namespace falcon { namespace regex_dfa {
+
+namespace {
+
+constexpr std::size_t block_size = 8;
+
+template<class GetPattern>
+std::vector<CompileResult> basic_compile_all(
+  std::size_t n, unsigned nb_threads, ScanOptions const & options, GetPattern get_pattern)
+{
+  std::vector<CompileResult> results(n);
+  std::atomic<std::size_t> next {0};
+
+  auto run = [&]{
+    Compiler compiler;
+    std::size_t first;
+    while ((first = next.fetch_add(block_size, std::memory_order_relaxed)) < n) {
+      auto const last = std::min(first + block_size, n);
+      for (std::size_t i = first; i < last; ++i) {
+        try {
+          results[i].ranges = compiler.scan(get_pattern(i), options);
+        }
+        catch (std::exception const & e) {
+          results[i].error = *e.what() ? e.what() : "invalid pattern";
+        }
+      }
+    }
+  };
+
+  nb_threads = unsigned(std::min<std::size_t>(nb_threads, (n + block_size - 1) / block_size));
+  std::vector<std::thread> threads;
+  threads.reserve(nb_threads);
+  for (unsigned i = 1; i < nb_threads; ++i) {
+    try {
+      threads.emplace_back(run);
+    }
+    catch (std::system_error const &) {
+      // fewer threads
+      break;
+    }
+  }
+  run();
+  for (auto & thread : threads) {
+    thread.join();
+  }
+
+  return results;
+}
+
+}
+
+std::vector<CompileResult> compile_all(
+  char const * const * patterns, std::size_t n, unsigned nb_threads,
+  const ScanOptions& options)
+{
+  return basic_compile_all(n, nb_threads, options, [patterns](std::size_t i) {
+    return patterns[i];
+  });
+}
+
+std::vector<CompileResult> compile_all(
+  std::vector<std::string> const & patterns, unsigned nb_threads,
+  const ScanOptions& options)
+{
+  return basic_compile_all(patterns.size(), nb_threads, options, [&patterns](std::size_t i) {
+    return patterns[i].c_str();
+  });
+}
+
+} }
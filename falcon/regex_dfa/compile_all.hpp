@@ -0,0 +1,44 @@
+#ifndef FALCON_REGEX_DFA_COMPILE_ALL_HPP
+#define FALCON_REGEX_DFA_COMPILE_ALL_HPP
+
+#include "redfa.hpp"
+#include "scan.hpp"
+
+#include <string>
+#include <vector>
+#include <thread>
+
+
+namespace falcon { namespace regex_dfa {
+
+struct CompileResult
+{
+  Ranges ranges;
+  /// message of the std::runtime_error of scan(), empty on success
+  std::string error;
+
+  bool ok() const { return error.empty(); }
+};
+
+/// scan() of each pattern with options and nb_threads threads
+/// (0 for the calling thread only).
+///
+/// The threads take the patterns by small blocks, a slow pattern doesn't
+/// hold the others. An invalid pattern doesn't stop the batch.
+/// \return  a result per pattern, in the same order
+std::vector<CompileResult> compile_all(
+  char const * const * patterns,
+  std::size_t n,
+  unsigned nb_threads = std::thread::hardware_concurrency(),
+  ScanOptions const & options = {}
+);
+
+std::vector<CompileResult> compile_all(
+  std::vector<std::string> const & patterns,
+  unsigned nb_threads = std::thread::hardware_concurrency(),
+  ScanOptions const & options = {}
+);
+
+} }
+
+#endif
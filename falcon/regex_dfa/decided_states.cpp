@@ -0,0 +1,98 @@
+#include "decided_states.hpp"
+#include "redfa.hpp"
+
+#include <algorithm>
+
+
+namespace falcon { namespace regex_dfa {
+
+namespace {
+
+/// \return  true when events contain every character except 0
+bool is_full(std::vector<Event> & events)
+{
+  std::sort(events.begin(), events.end());
+  char_int c = 1;
+  for (Event const & e : events) {
+    if (e.l > c) {
+      return false;
+    }
+    if (e.r == ~char_int{}) {
+      return true;
+    }
+    c = std::max(c, e.r + 1);
+  }
+  return false;
+}
+
+}
+
+void mark_decided_states(Ranges& rngs)
+{
+  auto const n = rngs.size();
+  auto is_final = [&rngs](std::size_t i) {
+    return bool(rngs[i].states & (Range::Final | Range::Eol));
+  };
+
+  // the final ranges until every one is complete with the others
+  std::vector<bool> accept_all(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    accept_all[i] = is_final(i);
+  }
+  std::vector<Event> events;
+  for (bool changed = true; changed; ) {
+    changed = false;
+    for (std::size_t i = 0; i < n; ++i) {
+      if (!accept_all[i]) {
+        continue;
+      }
+      events.clear();
+      for (auto & t : rngs[i].transitions) {
+        if ((t.states & Transition::Normal) && accept_all[t.next]) {
+          events.push_back(t.e);
+        }
+      }
+      if (!is_full(events)) {
+        accept_all[i] = false;
+        changed = true;
+      }
+    }
+  }
+
+  // the predecessors of the final ranges
+  std::vector<std::vector<std::size_t>> predecessors(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    for (auto & t : rngs[i].transitions) {
+      predecessors[t.next].push_back(i);
+    }
+  }
+  std::vector<bool> is_alive(n);
+  std::vector<std::size_t> stack;
+  for (std::size_t i = 0; i < n; ++i) {
+    if (is_final(i)) {
+      is_alive[i] = true;
+      stack.push_back(i);
+    }
+  }
+  while (!stack.empty()) {
+    auto const i = stack.back();
+    stack.pop_back();
+    for (auto j : predecessors[i]) {
+      if (!is_alive[j]) {
+        is_alive[j] = true;
+        stack.push_back(j);
+      }
+    }
+  }
+
+  for (std::size_t i = 0; i < n; ++i) {
+    if (accept_all[i]) {
+      rngs[i].hints |= Range::AcceptAll;
+    }
+    if (!is_alive[i]) {
+      rngs[i].hints |= Range::Dead;
+    }
+  }
+}
+
+} }
@@ -0,0 +1,16 @@
+#ifndef FALCON_REGEX_DFA_DECIDED_STATES_HPP
+#define FALCON_REGEX_DFA_DECIDED_STATES_HPP
+
+namespace falcon { namespace regex_dfa {
+
+class Ranges;
+
+/// Set Range::AcceptAll on the final ranges where any character leads to
+/// a Range::AcceptAll (as the loop of ".*") and Range::Dead on the ranges
+/// without path to a final range.
+/// The result of the matchers is known as soon as they enter one of them.
+void mark_decided_states(Ranges & rngs);
+
+} }
+
+#endif
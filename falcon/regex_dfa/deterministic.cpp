@@ -0,0 +1,82 @@
+#include "deterministic.hpp"
+#include "redfa.hpp"
+#include "range_iterator.hpp"
+
+#include <algorithm>
+
+
+namespace falcon { namespace regex_dfa {
+
+bool is_deterministic(const Ranges& rngs)
+{
+  std::vector<Transition const *> ts;
+
+  for (auto & rng : rngs) {
+    // the first character is the only one to consume Bol transitions
+    // and it is always consumed from the first range
+    auto const states = &rng == &rngs.front()
+      ? Transition::Normal | Transition::Bol
+      : Transition::Normal;
+
+    ts.clear();
+    for (auto & t : rng.transitions) {
+      if (t.states & states) {
+        ts.push_back(&t);
+      }
+    }
+
+    if (ts.size() < 2) {
+      continue;
+    }
+
+    std::sort(ts.begin(), ts.end(), [](Transition const * t1, Transition const * t2) {
+      return t1->e.l < t2->e.l;
+    });
+
+    Transition const * last = ts.front();
+    for (auto pt : make_range(ts.begin() + 1, ts.end())) {
+      if (pt->e.l <= last->e.r && pt->next != last->next) {
+        return false;
+      }
+      if (pt->e.r > last->e.r) {
+        last = pt;
+      }
+    }
+  }
+
+  return true;
+}
+
+void sorted_intervals(Intervals& intervals, const Range& rng, Transition::State states)
+{
+  intervals.clear();
+  for (auto & t : rng.transitions) {
+    if (t.states & states) {
+      intervals.push_back({t.e, t.next});
+    }
+  }
+
+  std::sort(intervals.begin(), intervals.end(), [](Interval const & a, Interval const & b) {
+    return a.e.l < b.e.l;
+  });
+
+  auto first = intervals.begin();
+  auto last = intervals.end();
+  if (first == last) {
+    return;
+  }
+  auto result = first;
+  while (++first != last) {
+    if (first->next == result->next
+     && (first->e.l <= result->e.r || first->e.l == result->e.r + 1)
+    ) {
+      result->e.r = std::max(result->e.r, first->e.r);
+    }
+    else {
+      *++result = *first;
+    }
+  }
+  intervals.erase(++result, last);
+}
+
+} }
@@ -0,0 +1,26 @@
+#ifndef FALCON_REGEX_DFA_DETERMINISTIC_HPP
+#define FALCON_REGEX_DFA_DETERMINISTIC_HPP
+
+#include "redfa.hpp"
+
+namespace falcon { namespace regex_dfa {
+
+/// \return  true when at most one transition can be taken for each character
+bool is_deterministic(Ranges const & rngs);
+
+struct Interval
+{
+  Event e;
+  std::size_t next;
+};
+
+using Intervals = std::vector<Interval>;
+
+/// Transitions of rng that match states, sorted and without overlap
+/// (the contiguous intervals with the same next are merged).
+/// \pre  the automaton of rng is deterministic
+void sorted_intervals(Intervals & intervals, Range const & rng, Transition::State states);
+
+} }
+
+#endif
@@ -0,0 +1,104 @@
+#include "disk_cache.hpp"
+
+#include <stdexcept>
+#include <fstream>
+#include <thread>
+#include <cstring>
+#include <cstdio>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace falcon { namespace regex_dfa {
+
+namespace {
+
+uint64_t hash(char const * s, std::size_t n, uint64_t h = 14695981039346656037u)
+{
+  for (auto e = s + n; s != e; ++s) {
+    h ^= static_cast<unsigned char>(*s);
+    h *= 1099511628211u;
+  }
+  return h;
+}
+
+/// options_bits() then pattern, stored after the image
+std::string make_key(char const * pattern, ScanOptions const & options)
+{
+  std::string key(1, char(options_bits(options)));
+  key += pattern;
+  return key;
+}
+
+bool has_key(MappedRanges const & mapped, std::string const & key)
+{
+  auto const h = mapped.ranges().header();
+  return mapped.size() == h->size + key.size()
+      && !std::memcmp(reinterpret_cast<char const *>(h) + h->size, key.data(), key.size());
+}
+
+}
+
+DiskCache::DiskCache(std::string directory)
+: directory_(std::move(directory))
+{
+  if (::mkdir(directory_.c_str(), 0777) == -1) {
+    struct stat st;
+    if (::stat(directory_.c_str(), &st) == -1 || !S_ISDIR(st.st_mode)) {
+      throw std::runtime_error("cannot create " + directory_);
+    }
+  }
+}
+
+std::string DiskCache::filename(const char* pattern, const ScanOptions& options) const
+{
+  uint64_t const version = flat::version;
+  uint64_t h = hash(reinterpret_cast<char const *>(&version), sizeof(version));
+  auto const key = make_key(pattern, options);
+  h = hash(key.data(), key.size(), h);
+
+  char name[24];
+  std::snprintf(name, sizeof(name), "/%016llx.rdfa", static_cast<unsigned long long>(h));
+  return directory_ + name;
+}
+
+MappedRanges DiskCache::get(const char* pattern, const ScanOptions& options)
+{
+  auto const file = filename(pattern, options);
+  auto const key = make_key(pattern, options);
+
+  try {
+    MappedRanges mapped(file.c_str());
+    if (has_key(mapped, key)) {
+      ++hits_;
+      return mapped;
+    }
+  }
+  catch (std::runtime_error const &) {
+  }
+
+  ++misses_;
+
+  std::string const image = serialize(scan(pattern, options));
+
+  std::string const tmp = file + "." + std::to_string(::getpid()) + "."
+    + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+  {
+    std::ofstream out(tmp, std::ios::binary);
+    out << image << key;
+    if (!out.flush()) {
+      out.close();
+      std::remove(tmp.c_str());
+      throw std::runtime_error("cannot write " + tmp);
+    }
+  }
+  if (std::rename(tmp.c_str(), file.c_str())) {
+    std::remove(tmp.c_str());
+    throw std::runtime_error("cannot rename " + tmp);
+  }
+
+  return MappedRanges(file.c_str());
+}
+
+} }
@@ -0,0 +1,47 @@
+#ifndef FALCON_REGEX_DFA_DISK_CACHE_HPP
+#define FALCON_REGEX_DFA_DISK_CACHE_HPP
+
+#include "flat_ranges.hpp"
+#include "scan.hpp"
+
+#include <string>
+#include <atomic>
+
+
+namespace falcon { namespace regex_dfa {
+
+/// Directory of images (see serialize()) indexed by a hash of the pattern,
+/// of the ScanOptions and of the image version.
+///
+/// The options and the pattern are stored after the image to detect collisions.
+/// Missing, corrupted or colliding files are rewritten in a temporary
+/// file then renamed, so concurrent processes only see complete files.
+/// The class is thread safe.
+class DiskCache
+{
+public:
+  struct Stats
+  {
+    uint64_t hits;
+    uint64_t misses;
+  };
+
+  /// \throw std::runtime_error when directory doesn't exist and cannot be created
+  explicit DiskCache(std::string directory);
+
+  /// \throw std::runtime_error from scan() or when the file cannot be written
+  MappedRanges get(char const * pattern, ScanOptions const & options = {});
+
+  std::string filename(char const * pattern, ScanOptions const & options = {}) const;
+
+  Stats stats() const { return {hits_, misses_}; }
+
+private:
+  std::string directory_;
+  std::atomic<uint64_t> hits_ {0};
+  std::atomic<uint64_t> misses_ {0};
+};
+
+} }
+
+#endif
@@ -0,0 +1,251 @@
+#include "factorize.hpp"
+#include "redfa.hpp"
+#include "deterministic.hpp"
+#include "skip_states.hpp"
+#include "decided_states.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+
+namespace falcon { namespace regex_dfa {
+
+namespace {
+
+void add_transitions(Transitions & ts, Transitions const & added)
+{
+  for (auto & t : added) {
+    if (std::find(ts.begin(), ts.end(), t) == ts.end()) {
+      ts.push_back(t);
+    }
+  }
+}
+
+void remove_duplicates(Transitions & ts)
+{
+  auto last = ts.begin();
+  for (auto & t : ts) {
+    if (std::find(ts.begin(), last, t) == last) {
+      *last++ = t;
+    }
+  }
+  ts.erase(last, ts.end());
+}
+
+Range::State merge_states(Range::State a, Range::State b)
+{
+  auto states = a | b;
+  if (states & (Range::Final | Range::Eol)) {
+    states &= ~Range::Normal;
+  }
+  return states;
+}
+
+struct PrefixFactorizer
+{
+  Ranges & rngs;
+  std::vector<std::size_t> degrees;
+
+  explicit PrefixFactorizer(Ranges & rngs)
+  : rngs(rngs)
+  , degrees(rngs.size())
+  {
+    for (auto & rng : rngs) {
+      for (auto & t : rng.transitions) {
+        ++degrees[t.next];
+      }
+    }
+  }
+
+  /// Two transitions of rngs[i] with the same event go to j and k.
+  /// When k is only reached by its transition, the transitions of j can
+  /// be copied in k and the transition to j removed: the futures are the
+  /// same. A final range can receive a non final one.
+  bool merge_one(std::size_t i)
+  {
+    Transitions & ts = rngs[i].transitions;
+    for (std::size_t a = 0; a < ts.size(); ++a) {
+      for (std::size_t b = 0; b < ts.size(); ++b) {
+        auto const j = ts[a].next;
+        auto const k = ts[b].next;
+        if (a != b && j != k && is_mergeable(i, j, k)
+         && ts[a].e == ts[b].e && ts[a].states == ts[b].states
+        ) {
+          ts.erase(ts.begin() + static_cast<std::ptrdiff_t>(a));
+          merge(j, k);
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+private:
+  // range 0 is the start, it is never merged
+  bool is_mergeable(std::size_t i, std::size_t j, std::size_t k) const
+  {
+    return j && k && j != i && k != i && degrees[k] == 1
+        && (rngs[j].states & Range::Bol) == (rngs[k].states & Range::Bol)
+        && rngs[j].capstates == rngs[k].capstates;
+  }
+
+  /// copy j in k, the transition to j is already removed
+  void merge(std::size_t j, std::size_t k)
+  {
+    Transitions & ts = rngs[k].transitions;
+    auto const size = ts.size();
+    rngs[k].states = merge_states(rngs[k].states, rngs[j].states);
+    add_transitions(ts, rngs[j].transitions);
+    for (auto it = ts.begin() + static_cast<std::ptrdiff_t>(size); it != ts.end(); ++it) {
+      ++degrees[it->next];
+    }
+
+    if (!--degrees[j]) {
+      for (auto & t : rngs[j].transitions) {
+        --degrees[t.next];
+      }
+      rngs[j].transitions.clear();
+    }
+  }
+};
+
+bool factorize_prefixes(Ranges & rngs)
+{
+  PrefixFactorizer factorizer(rngs);
+  bool changed = false;
+  for (std::size_t i = 0; i < rngs.size(); ++i) {
+    while (factorizer.merge_one(i)) {
+      changed = true;
+    }
+  }
+  return changed;
+}
+
+bool factorize_suffixes(Ranges & rngs)
+{
+  std::vector<Transitions> sorted_ts(rngs.size());
+  for (std::size_t i = 0; i < rngs.size(); ++i) {
+    sorted_ts[i] = rngs[i].transitions;
+    std::sort(sorted_ts[i].begin(), sorted_ts[i].end());
+  }
+
+  auto less = [&](std::size_t i, std::size_t j) {
+    Range const & a = rngs[i];
+    Range const & b = rngs[j];
+    if (!(a.states == b.states)) {
+      return a.states < b.states;
+    }
+    if (!(a.capstates == b.capstates)) {
+      return std::lexicographical_compare(
+        a.capstates.begin(), a.capstates.end(), b.capstates.begin(), b.capstates.end());
+    }
+    return std::lexicographical_compare(
+      sorted_ts[i].begin(), sorted_ts[i].end(), sorted_ts[j].begin(), sorted_ts[j].end());
+  };
+
+  // equal ranges are adjacent, range 0 is excluded
+  std::vector<std::size_t> indexes(rngs.size() - 1u);
+  std::iota(indexes.begin(), indexes.end(), std::size_t{1});
+  std::sort(indexes.begin(), indexes.end(), less);
+
+  std::vector<std::size_t> to(rngs.size());
+  std::iota(to.begin(), to.end(), std::size_t{0});
+  bool changed = false;
+  for (std::size_t n = 1; n < indexes.size(); ++n) {
+    auto const prev = indexes[n-1];
+    auto const i = indexes[n];
+    if (!less(prev, i)) {
+      to[i] = to[prev];
+      changed = true;
+    }
+  }
+
+  if (changed) {
+    for (auto & rng : rngs) {
+      for (auto & t : rng.transitions) {
+        t.next = to[t.next];
+      }
+      remove_duplicates(rng.transitions);
+    }
+  }
+  return changed;
+}
+
+void remove_unreachable(Ranges & rngs)
+{
+  constexpr auto unreachable = ~std::size_t{};
+  std::vector<std::size_t> to(rngs.size(), unreachable);
+  std::vector<std::size_t> stack {0};
+  to[0] = 0;
+  std::size_t n = 1;
+  while (!stack.empty()) {
+    auto const i = stack.back();
+    stack.pop_back();
+    for (auto & t : rngs[i].transitions) {
+      if (to[t.next] == unreachable) {
+        to[t.next] = 0;
+        ++n;
+        stack.push_back(t.next);
+      }
+    }
+  }
+
+  if (n == rngs.size()) {
+    return ;
+  }
+
+  // the order of the ranges is kept
+  n = 0;
+  for (auto & i : to) {
+    if (i != unreachable) {
+      i = n++;
+    }
+  }
+
+  std::size_t i = 0;
+  for (auto & rng : rngs) {
+    if (to[i] != unreachable) {
+      for (auto & t : rng.transitions) {
+        t.next = to[t.next];
+      }
+      if (to[i] != i) {
+        rngs[to[i]] = std::move(rng);
+      }
+    }
+    ++i;
+  }
+  rngs.resize(n);
+}
+
+}
+
+void factorize(Ranges& rngs)
+{
+  if (rngs.empty()) {
+    return ;
+  }
+
+  // the pipes of scan() are unreachable but count as predecessors
+  remove_unreachable(rngs);
+
+  // a shared suffix has several predecessors and stops the merge of
+  // the prefixes, so the prefixes are done first
+  // the copies of transitions can create new pairs in loops,
+  // the number of passes is bounded
+  for (auto n = rngs.size(); n && factorize_prefixes(rngs); --n) {
+    remove_unreachable(rngs);
+  }
+  while (factorize_suffixes(rngs)) {
+    remove_unreachable(rngs);
+  }
+
+  for (auto & rng : rngs) {
+    rng.hints = Range::NoHint;
+    rng.escapes[0] = 0;
+  }
+  rngs.is_deterministic = is_deterministic(rngs);
+  mark_skip_states(rngs);
+  mark_decided_states(rngs);
+}
+
+} }
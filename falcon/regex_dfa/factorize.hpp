@@ -0,0 +1,22 @@
+#ifndef FALCON_REGEX_DFA_FACTORIZE_HPP
+#define FALCON_REGEX_DFA_FACTORIZE_HPP
+
+namespace falcon { namespace regex_dfa {
+
+class Ranges;
+
+/// Share the common prefixes and suffixes of the branches of rngs.
+///
+/// Prefixes: when two transitions of a range have the same event, as the
+/// first characters of "ab|ac", and one of the targets has no other
+/// predecessor, it receives the transitions of the other target.
+/// Suffixes: two ranges with the same states, captures and transitions,
+/// as the ends of "ab|cb", become one.
+/// Ranges with different captures are never merged, the matches and the
+/// captures are unchanged. The unreachable ranges are removed,
+/// is_deterministic and the hints are computed again.
+void factorize(Ranges & rngs);
+
+} }
+
+#endif
@@ -0,0 +1,281 @@
+#include "flat_ranges.hpp"
+
+#include <stdexcept>
+#include <ostream>
+#include <cstring>
+#include <algorithm>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+
+namespace falcon { namespace regex_dfa {
+
+uint32_t flat::checksum(void const * data, std::size_t size)
+{
+  auto p = static_cast<unsigned char const *>(data);
+  uint32_t h = 2166136261u;
+  for (auto e = p + size; p != e; ++p) {
+    h ^= *p;
+    h *= 16777619u;
+  }
+  return h;
+}
+
+namespace {
+
+template<class T>
+std::size_t bytes(uint32_t n)
+{
+  return sizeof(T) * n;
+}
+
+template<class T>
+T const * at(char const * p, std::size_t & offset, uint32_t n)
+{
+  auto const r = reinterpret_cast<T const *>(p + offset);
+  offset += bytes<T>(n);
+  return r;
+}
+
+}
+
+FlatRanges::FlatRanges(const void* data, std::size_t size)
+{
+  auto const p = static_cast<char const *>(data);
+
+  if (size < sizeof(flat::Header)) {
+    throw std::runtime_error("truncated image");
+  }
+  if (reinterpret_cast<std::uintptr_t>(p) % alignof(flat::Header)) {
+    throw std::runtime_error("misaligned image");
+  }
+
+  auto const h = reinterpret_cast<flat::Header const *>(p);
+  if (h->magic != flat::magic) {
+    throw std::runtime_error("not a regex_dfa image");
+  }
+  if (h->endian != flat::endian) {
+    throw std::runtime_error("image with a different byte order");
+  }
+  if (h->version != flat::version) {
+    throw std::runtime_error("unsupported image version");
+  }
+  std::size_t const expected_size
+    = sizeof(flat::Header)
+    + bytes<flat::Range>(h->nb_ranges)
+    + bytes<flat::Transition>(h->nb_transitions)
+    + bytes<flat::Capture>(h->nb_captures)
+    + bytes<uint32_t>(h->nb_capture_table);
+  if (h->size != expected_size || size < expected_size) {
+    throw std::runtime_error("truncated image");
+  }
+  if (h->checksum != flat::checksum(h + 1, expected_size - sizeof(flat::Header))) {
+    throw std::runtime_error("bad image checksum");
+  }
+
+  std::size_t offset = sizeof(flat::Header);
+  rngs_ = at<flat::Range>(p, offset, h->nb_ranges);
+  ts_ = at<flat::Transition>(p, offset, h->nb_transitions);
+  caps_ = at<flat::Capture>(p, offset, h->nb_captures);
+  capture_table_ = at<uint32_t>(p, offset, h->nb_capture_table);
+
+  for (auto & rng : make_range(rngs_, rngs_ + h->nb_ranges)) {
+    if (uint64_t{rng.first_transition} + rng.nb_transitions > h->nb_transitions
+     || uint64_t{rng.first_capture} + rng.nb_captures > h->nb_captures
+     || rng.escapes[sizeof(rng.escapes) - 1]
+    ) {
+      throw std::runtime_error("corrupted image");
+    }
+  }
+  for (auto & t : make_range(ts_, ts_ + h->nb_transitions)) {
+    if (t.next >= h->nb_ranges) {
+      throw std::runtime_error("corrupted image");
+    }
+  }
+
+  header_ = h;
+  is_deterministic = bool(h->flags & flat::Deterministic);
+}
+
+FlatRanges::FlatRanges(flat::Header const * h)
+{
+  auto const p = reinterpret_cast<char const *>(h);
+  std::size_t offset = sizeof(flat::Header);
+  rngs_ = at<flat::Range>(p, offset, h->nb_ranges);
+  ts_ = at<flat::Transition>(p, offset, h->nb_transitions);
+  caps_ = at<flat::Capture>(p, offset, h->nb_captures);
+  capture_table_ = at<uint32_t>(p, offset, h->nb_capture_table);
+  header_ = h;
+  is_deterministic = bool(h->flags & flat::Deterministic);
+}
+
+
+namespace {
+
+flat::Header image_header(const Ranges& rngs)
+{
+  flat::Header h {};
+  h.magic = flat::magic;
+  h.version = flat::version;
+  h.endian = flat::endian;
+  h.flags = rngs.is_deterministic ? flat::Deterministic : flat::NoFlag;
+  h.nb_ranges = uint32_t(rngs.size());
+  h.nb_capture_table = uint32_t(rngs.capture_table.size());
+  for (auto & rng : rngs) {
+    h.nb_transitions += uint32_t(rng.transitions.size());
+    h.nb_captures += uint32_t(rng.capstates.size());
+  }
+  h.size
+    = sizeof(flat::Header)
+    + bytes<flat::Range>(h.nb_ranges)
+    + bytes<flat::Transition>(h.nb_transitions)
+    + bytes<flat::Capture>(h.nb_captures)
+    + bytes<uint32_t>(h.nb_capture_table);
+  return h;
+}
+
+/// p is zero initialized with h.size bytes
+void write_image(char * p, flat::Header h, const Ranges& rngs)
+{
+  std::size_t offset = sizeof(flat::Header);
+  auto frngs = const_cast<flat::Range *>(at<flat::Range>(p, offset, h.nb_ranges));
+  auto fts = const_cast<flat::Transition *>(at<flat::Transition>(p, offset, h.nb_transitions));
+  auto fcaps = const_cast<flat::Capture *>(at<flat::Capture>(p, offset, h.nb_captures));
+  auto ftable = const_cast<uint32_t *>(at<uint32_t>(p, offset, h.nb_capture_table));
+
+  uint32_t its = 0;
+  uint32_t icaps = 0;
+  for (auto & rng : rngs) {
+    flat::Range & frng = *frngs++;
+    frng.states = rng.states;
+    frng.hints = rng.hints;
+    frng.first_transition = its;
+    frng.nb_transitions = uint32_t(rng.transitions.size());
+    frng.first_capture = icaps;
+    frng.nb_captures = uint32_t(rng.capstates.size());
+    std::memcpy(frng.escapes, rng.escapes, sizeof(frng.escapes));
+    for (auto & t : rng.transitions) {
+      fts[its++] = {t.e, uint32_t(t.next), uint32_t(t.states)};
+    }
+    for (auto & cap : rng.capstates) {
+      fcaps[icaps++] = {cap.n, uint32_t(cap.e)};
+    }
+  }
+  std::copy(rngs.capture_table.begin(), rngs.capture_table.end(), ftable);
+
+  h.checksum = flat::checksum(p + sizeof(flat::Header), h.size - sizeof(flat::Header));
+  std::memcpy(p, &h, sizeof(h));
+}
+
+}
+
+std::string serialize(const Ranges& rngs)
+{
+  auto const h = image_header(rngs);
+  std::string image(h.size, '\0');
+  write_image(&image[0], h, rngs);
+  return image;
+}
+
+FlatRanges serialize(const Ranges& rngs, FlatArena& arena)
+{
+  auto const h = image_header(rngs);
+  auto const p = static_cast<char *>(arena.allocate(h.size));
+  std::memset(p, 0, h.size);
+  write_image(p, h, rngs);
+  return FlatRanges(reinterpret_cast<flat::Header const *>(p));
+}
+
+void serialize(std::ostream& out, const Ranges& rngs)
+{
+  auto const image = serialize(rngs);
+  out.write(image.data(), std::streamsize(image.size()));
+}
+
+
+FlatArena::FlatArena(std::size_t block_size)
+: block_size_(block_size)
+{}
+
+void* FlatArena::allocate(std::size_t n)
+{
+  constexpr std::size_t align = alignof(flat::Header);
+  n = (n + align - 1u) / align * align;
+  if (n > remaining_) {
+    auto const sz = std::max(n, block_size_);
+    blocks_.emplace_back(new char[sz]);
+    p_ = blocks_.back().get();
+    remaining_ = sz;
+  }
+  void * r = p_;
+  p_ += n;
+  remaining_ -= n;
+  return r;
+}
+
+void FlatArena::release()
+{
+  blocks_.clear();
+  p_ = nullptr;
+  remaining_ = 0;
+}
+
+
+MappedRanges::MappedRanges(const char* filename)
+{
+  int const fd = ::open(filename, O_RDONLY | O_CLOEXEC);
+  if (fd == -1) {
+    throw std::runtime_error(std::string("cannot open ") + filename);
+  }
+
+  struct stat st;
+  if (::fstat(fd, &st) == -1 || st.st_size <= 0) {
+    ::close(fd);
+    throw std::runtime_error(std::string("cannot read ") + filename);
+  }
+
+  size_ = std::size_t(st.st_size);
+  data_ = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (data_ == MAP_FAILED) {
+    data_ = nullptr;
+    throw std::runtime_error(std::string("cannot map ") + filename);
+  }
+
+  try {
+    rngs_ = FlatRanges(data_, size_);
+  }
+  catch (...) {
+    ::munmap(data_, size_);
+    throw;
+  }
+}
+
+MappedRanges::MappedRanges(MappedRanges&& other) noexcept
+: data_(other.data_)
+, size_(other.size_)
+, rngs_(other.rngs_)
+{
+  other.data_ = nullptr;
+  other.rngs_ = FlatRanges();
+}
+
+MappedRanges& MappedRanges::operator=(MappedRanges&& other) noexcept
+{
+  std::swap(data_, other.data_);
+  std::swap(size_, other.size_);
+  std::swap(rngs_, other.rngs_);
+  return *this;
+}
+
+MappedRanges::~MappedRanges()
+{
+  if (data_) {
+    ::munmap(data_, size_);
+  }
+}
+
+} }
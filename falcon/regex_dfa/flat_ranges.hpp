@@ -0,0 +1,180 @@
+#ifndef FALCON_REGEX_DFA_FLAT_RANGES_HPP
+#define FALCON_REGEX_DFA_FLAT_RANGES_HPP
+
+#include "redfa.hpp"
+#include "range_iterator.hpp"
+
+#include <string>
+#include <iosfwd>
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+
+namespace falcon { namespace regex_dfa {
+
+/// Binary image of a Ranges, used in place (see MappedRanges).
+///
+/// Layout: Header, Range[nb_ranges], Transition[nb_transitions],
+/// Capture[nb_captures], uint32_t[nb_capture_table].
+/// Integers are in the byte order of the writer, indicated by Header::endian.
+namespace flat {
+  constexpr uint32_t magic = 0x41464452; // "RDFA" in little endian
+  /// incremented when the layout or the Ranges made by scan() for a pattern change
+  constexpr uint16_t version = 3;
+  constexpr uint16_t endian = 0x0102;
+
+  enum Flag : uint32_t {
+    NoFlag = 0,
+    Deterministic = 1 << 0,
+  };
+
+  struct Header
+  {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t endian;
+    uint32_t flags;
+    uint32_t nb_ranges;
+    uint32_t nb_transitions;
+    uint32_t nb_captures;
+    uint32_t nb_capture_table;
+    /// of the bytes following the header
+    uint32_t checksum;
+    uint64_t size;
+  };
+
+  struct Range
+  {
+    uint32_t states;
+    uint32_t hints;
+    uint32_t first_transition;
+    uint32_t nb_transitions;
+    uint32_t first_capture;
+    uint32_t nb_captures;
+    char escapes[4];
+  };
+
+  struct Transition
+  {
+    Event e;
+    uint32_t next;
+    uint32_t states;
+  };
+
+  struct Capture
+  {
+    uint32_t n;
+    uint32_t e;
+  };
+
+  /// fnv-1a
+  uint32_t checksum(void const * data, std::size_t size);
+}
+
+class FlatArena;
+
+/// View on a binary image, no copy.
+class FlatRanges
+{
+public:
+  struct RangeView
+  {
+    uint32_t states;
+    uint32_t hints;
+    char const * escapes;
+    range_iterator<flat::Transition const *> transitions;
+    range_iterator<flat::Capture const *> capstates;
+  };
+
+  FlatRanges() = default;
+
+  /// \throw std::runtime_error when data isn't a valid image
+  FlatRanges(void const * data, std::size_t size);
+
+  std::size_t size() const { return header_ ? header_->nb_ranges : 0; }
+  bool empty() const { return !size(); }
+
+  RangeView operator[](std::size_t i) const
+  {
+    flat::Range const & rng = rngs_[i];
+    return {
+      rng.states,
+      rng.hints,
+      rng.escapes,
+      make_range(ts_ + rng.first_transition, ts_ + rng.first_transition + rng.nb_transitions),
+      make_range(caps_ + rng.first_capture, caps_ + rng.first_capture + rng.nb_captures),
+    };
+  }
+
+  range_iterator<uint32_t const *> capture_table() const
+  { return make_range(capture_table_, capture_table_ + (header_ ? header_->nb_capture_table : 0)); }
+
+  flat::Header const * header() const { return header_; }
+
+  /// copy of the header flag
+  bool is_deterministic = false;
+
+private:
+  friend FlatRanges serialize(Ranges const & rngs, FlatArena & arena);
+
+  /// view on an image written by this process, without validation
+  explicit FlatRanges(flat::Header const * h);
+
+  flat::Header const * header_ = nullptr;
+  flat::Range const * rngs_ = nullptr;
+  flat::Transition const * ts_ = nullptr;
+  flat::Capture const * caps_ = nullptr;
+  uint32_t const * capture_table_ = nullptr;
+};
+
+/// Monotonic memory for images: allocations live until release() or the
+/// destruction of the arena.
+class FlatArena
+{
+public:
+  explicit FlatArena(std::size_t block_size = 64 * 1024);
+
+  /// \return  memory aligned for a flat::Header
+  void * allocate(std::size_t n);
+
+  /// free every block
+  void release();
+
+private:
+  std::vector<std::unique_ptr<char[]>> blocks_;
+  char * p_ = nullptr;
+  std::size_t remaining_ = 0;
+  std::size_t block_size_;
+};
+
+/// \return  binary image of rngs
+std::string serialize(Ranges const & rngs);
+void serialize(std::ostream & out, Ranges const & rngs);
+/// \return  view on a binary image allocated in arena
+FlatRanges serialize(Ranges const & rngs, FlatArena & arena);
+
+/// Read only mapping of a file created with serialize().
+class MappedRanges
+{
+public:
+  /// \throw std::runtime_error
+  explicit MappedRanges(char const * filename);
+  MappedRanges(MappedRanges &&) noexcept;
+  MappedRanges & operator = (MappedRanges &&) noexcept;
+  ~MappedRanges();
+
+  FlatRanges const & ranges() const { return rngs_; }
+
+  /// size of the file
+  std::size_t size() const { return size_; }
+
+private:
+  void * data_ = nullptr;
+  std::size_t size_ = 0;
+  FlatRanges rngs_;
+};
+
+} }
+
+#endif
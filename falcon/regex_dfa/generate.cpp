@@ -0,0 +1,309 @@
+#include "generate.hpp"
+#include "match.hpp"
+
+#include <algorithm>
+
+
+namespace falcon { namespace regex_dfa {
+
+namespace {
+
+constexpr std::size_t unreachable = ~std::size_t{};
+
+bool is_final(Range const & rng)
+{
+  return bool(rng.states & (Range::Final | Range::Eol));
+}
+
+Transition::State applicable_states(std::size_t position)
+{
+  return position ? Transition::Normal : Transition::Normal | Transition::Bol;
+}
+
+bool is_continuation(char_int c)
+{
+  return (c & 0xC0) == 0x80;
+}
+
+}
+
+bool append_utf8(std::string& s, char_int c)
+{
+  char_int const lead
+    = c >> 24 ? c >> 24
+    : c >> 16 ? c >> 16
+    : c >> 8 ? c >> 8
+    : c;
+  unsigned const n = c >> 24 ? 4 : c >> 16 ? 3 : c >> 8 ? 2 : 1;
+
+  bool const valid_lead
+    = n == 1 ? (c && c < 0x80)
+    : n == 2 ? (lead >= 0xC2 && lead <= 0xDF)
+    : n == 3 ? (lead >= 0xE0 && lead <= 0xEF)
+    : (lead >= 0xF0 && lead <= 0xF4);
+  if (!valid_lead) {
+    return false;
+  }
+  for (unsigned i = 0; i + 1 < n; ++i) {
+    if (!is_continuation(c >> (8 * i))) {
+      return false;
+    }
+  }
+  for (unsigned i = n; i-- > 0;) {
+    s += char(c >> (8 * i));
+  }
+  return true;
+}
+
+
+Generator::Generator(const Ranges& rngs, uint64_t seed)
+: rngs_(rngs)
+, gen_(seed)
+, distances_(rngs.size(), unreachable)
+{
+  // shortest paths to a final range with Normal transitions
+  std::vector<std::vector<std::size_t>> previous(rngs.size());
+  std::vector<std::size_t> queue;
+  for (std::size_t i = 0; i < rngs.size(); ++i) {
+    if (is_final(rngs[i])) {
+      distances_[i] = 0;
+      queue.push_back(i);
+    }
+    for (auto & t : rngs[i].transitions) {
+      if (t.states & Transition::Normal) {
+        previous[t.next].push_back(i);
+      }
+    }
+  }
+  for (std::size_t q = 0; q < queue.size(); ++q) {
+    for (auto i : previous[queue[q]]) {
+      if (distances_[i] == unreachable) {
+        distances_[i] = distances_[queue[q]] + 1;
+        queue.push_back(i);
+      }
+    }
+  }
+}
+
+std::size_t Generator::random(std::size_t n)
+{
+  // the modulo of mt19937_64 is the same with every standard library
+  return std::size_t(gen_() % n);
+}
+
+bool Generator::pick(Event const & e, char_int & c)
+{
+  // mostly printable ASCII
+  char_int const l = std::max<char_int>(e.l, 0x20);
+  char_int const r = std::min<char_int>(e.r, 0x7e);
+  if (l <= r && (e.r <= 0x7f || random(8))) {
+    c = l + char_int(random(r - l + 1u));
+    return true;
+  }
+
+  std::string tmp;
+  auto const width = uint64_t{e.r} - e.l + 1u;
+  for (int i = 0; i < 8; ++i) {
+    c = char_int(e.l + gen_() % width);
+    if (append_utf8(tmp, c)) {
+      return true;
+    }
+  }
+
+  // random encoding of 1 to 4 bytes
+  for (int i = 0; i < 64; ++i) {
+    auto const n = random(4);
+    char_int const leads[][2] {{0x01, 0x7f}, {0xC2, 0xDF}, {0xE0, 0xEF}, {0xF0, 0xF4}};
+    c = leads[n][0] + char_int(random(leads[n][1] - leads[n][0] + 1u));
+    for (std::size_t k = 0; k < n; ++k) {
+      c = (c << 8) | char_int(0x80 + random(0x40));
+    }
+    if (e.contains(c)) {
+      return true;
+    }
+  }
+
+  c = e.l;
+  if (append_utf8(tmp, c)) {
+    return true;
+  }
+  c = e.r;
+  return append_utf8(tmp, c);
+}
+
+bool Generator::matching(std::string& s, std::size_t length)
+{
+  s.clear();
+  if (rngs_.empty()) {
+    return true;
+  }
+
+  std::size_t first_distance = is_final(rngs_[0]) ? 0 : unreachable;
+  for (auto & t : rngs_[0].transitions) {
+    if (distances_[t.next] != unreachable) {
+      first_distance = std::min(first_distance, distances_[t.next] + 1);
+    }
+  }
+  if (first_distance == unreachable) {
+    return false;
+  }
+
+  std::vector<std::pair<Transition const *, char_int>> candidates;
+  std::size_t i = 0;
+  std::size_t position = 0;
+  for (;;) {
+    auto const states = applicable_states(position);
+    auto const remaining = position < length ? length - position : 0;
+
+    // transitions that can still end in a final range in time,
+    // otherwise those of the shortest path
+    auto collect = [&](bool shortest) {
+      candidates.clear();
+      std::size_t best = unreachable;
+      for (auto & t : rngs_[i].transitions) {
+        auto const d = distances_[t.next];
+        if (!(t.states & states) || d == unreachable || (!shortest && d >= remaining)) {
+          continue;
+        }
+        char_int c;
+        if (!pick(t.e, c)) {
+          continue;
+        }
+        if (shortest && d < best) {
+          candidates.clear();
+          best = d;
+        }
+        if (!shortest || d == best) {
+          candidates.emplace_back(&t, c);
+        }
+      }
+    };
+
+    collect(!remaining);
+    if (candidates.empty() && remaining && !is_final(rngs_[i])) {
+      collect(true);
+    }
+
+    if ((!remaining || candidates.empty()) && is_final(rngs_[i])) {
+      return true;
+    }
+    if (candidates.empty()) {
+      return false;
+    }
+
+    auto const & choice = candidates[random(candidates.size())];
+    append_utf8(s, choice.second);
+    i = choice.first->next;
+    ++position;
+  }
+}
+
+bool Generator::near_miss(std::string& s, std::size_t length)
+{
+  std::string base;
+  for (int attempt = 0; attempt < 32; ++attempt) {
+    if (!matching(base, length)) {
+      return false;
+    }
+
+    // positions of the characters
+    std::vector<std::size_t> positions;
+    for (std::size_t i = 0; i < base.size(); ++i) {
+      if (!is_continuation(static_cast<unsigned char>(base[i]))) {
+        positions.push_back(i);
+      }
+    }
+    positions.push_back(base.size());
+
+    for (int mutation = 0; mutation < 8; ++mutation) {
+      auto const k = random(positions.size());
+      auto const first = positions[k];
+      auto const last = k + 1 < positions.size() ? positions[k + 1] : first;
+      char const * alphabet = "a0 _-.\"/\xc3\xa9";
+      std::string c;
+      if (!random(4)) {
+        c = "\xc3\xa9";
+      }
+      else {
+        c = alphabet[random(8)];
+      }
+
+      s = base;
+      switch (random(3)) {
+        case 0: s.replace(first, last - first, c); break;
+        case 1: s.erase(first, last - first); break;
+        default: s.insert(first, c); break;
+      }
+      if (!matches(rngs_, s.c_str())) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void Generator::adversarial(std::string& s, std::size_t length)
+{
+  s.clear();
+  if (rngs_.empty()) {
+    return;
+  }
+
+  std::vector<std::size_t> active {0};
+  std::vector<std::size_t> next;
+  std::vector<std::size_t> best_next;
+  std::vector<char> seen(rngs_.size());
+  std::vector<char_int> chars;
+
+  for (std::size_t position = 0; position < length && !active.empty(); ++position) {
+    auto const states = applicable_states(position);
+
+    chars.clear();
+    for (auto i : active) {
+      for (auto & t : rngs_[i].transitions) {
+        char_int c;
+        if ((t.states & states) && pick(t.e, c)) {
+          chars.push_back(c);
+        }
+      }
+    }
+    std::sort(chars.begin(), chars.end());
+    chars.erase(std::unique(chars.begin(), chars.end()), chars.end());
+    if (chars.empty()) {
+      break;
+    }
+
+    // greedy choice, ties broken at random
+    char_int best_char = 0;
+    std::size_t nb_best = 0;
+    best_next.clear();
+    for (auto c : chars) {
+      next.clear();
+      for (auto i : active) {
+        for (auto & t : rngs_[i].transitions) {
+          if ((t.states & states) && t.e.contains(c) && !seen[t.next]) {
+            seen[t.next] = 1;
+            next.push_back(t.next);
+          }
+        }
+      }
+      for (auto i : next) {
+        seen[i] = 0;
+      }
+      if (next.size() > best_next.size()
+       || (next.size() == best_next.size() && !random(++nb_best))
+      ) {
+        if (next.size() > best_next.size()) {
+          nb_best = 1;
+        }
+        best_next.swap(next);
+        best_char = c;
+      }
+    }
+
+    append_utf8(s, best_char);
+    active.swap(best_next);
+  }
+}
+
+} }
@@ -0,0 +1,52 @@
+#ifndef FALCON_REGEX_DFA_GENERATE_HPP
+#define FALCON_REGEX_DFA_GENERATE_HPP
+
+#include "redfa.hpp"
+
+#include <random>
+#include <string>
+
+
+namespace falcon { namespace regex_dfa {
+
+/// Strings for the tests and benchmarks of an automaton.
+///
+/// The characters are chosen in the events of random paths of transitions.
+/// A generator built with the same seed produces the same strings.
+class Generator
+{
+public:
+  Generator(Ranges const & rngs, uint64_t seed);
+
+  /// A string accepted by matches() of about length characters,
+  /// shorter or longer when the automaton requires it.
+  /// \return  false when the automaton doesn't accept any string
+  bool matching(std::string & s, std::size_t length);
+
+  /// A string rejected by matches() at one character of a matching string
+  /// (modified, removed or added).
+  /// \return  false when no such string is found
+  bool near_miss(std::string & s, std::size_t length);
+
+  /// A string of length characters that keeps the largest set of active
+  /// states in nfa_match() (greedy choice at each character).
+  void adversarial(std::string & s, std::size_t length);
+
+private:
+  /// \return  false when e doesn't contain a valid character
+  bool pick(Event const & e, char_int & c);
+  std::size_t random(std::size_t n);
+
+  Ranges const & rngs_;
+  std::mt19937_64 gen_;
+  /// number of characters to a final range, ~0 when unreachable
+  std::vector<std::size_t> distances_;
+};
+
+/// Append c in UTF-8 (as read by utf8_consumer).
+/// \return  false when c isn't a valid character
+bool append_utf8(std::string & s, char_int c);
+
+} }
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef FALCON_REGEX_DFA_HEATMAP_HPP
+#define FALCON_REGEX_DFA_HEATMAP_HPP
+
+#include <vector>
+#include <cstdint>
+
+
+namespace falcon { namespace regex_dfa {
+
+class Ranges;
+
+/// Visits of the ranges of an automaton, indexed by range.
+/// Accumulated by profile_matches() over any number of strings.
+struct Heatmap
+{
+  /// number of times the range became active
+  std::vector<uint64_t> entered;
+  /// number of transitions tested from the range
+  std::vector<uint64_t> tested;
+
+  void clear()
+  {
+    entered.clear();
+    tested.clear();
+  }
+};
+
+/// matches() that records the visits of the ranges in heatmap
+/// (resized to rngs.size()).
+bool profile_matches(Ranges const & rngs, char const * s, Heatmap & heatmap);
+
+} }
+
+#endif
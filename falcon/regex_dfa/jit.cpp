@@ -0,0 +1,299 @@
+#include "jit.hpp"
+#include "match.hpp"
+#include "deterministic.hpp"
+
+#if defined(__x86_64__) && defined(__linux__) && !defined(FALCON_REGEX_DFA_DISABLE_JIT)
+# define FALCON_REGEX_DFA_HAS_JIT 1
+#else
+# define FALCON_REGEX_DFA_HAS_JIT 0
+#endif
+
+#if FALCON_REGEX_DFA_HAS_JIT
+# include <cstring>
+# include <sys/mman.h>
+#endif
+
+
+namespace falcon { namespace regex_dfa {
+
+#if FALCON_REGEX_DFA_HAS_JIT
+namespace {
+
+using Code = std::vector<unsigned char>;
+
+/// x86-64 machine code with labels resolved at the end
+class Assembler
+{
+public:
+  using Label = std::size_t;
+
+  Label new_label()
+  {
+    labels_.push_back(~std::size_t{});
+    return labels_.size() - 1u;
+  }
+
+  void bind(Label label) { labels_[label] = code_.size(); }
+
+  void bytes(std::initializer_list<unsigned char> l)
+  { code_.insert(code_.end(), l.begin(), l.end()); }
+
+  void imm32(uint32_t n)
+  {
+    for (unsigned i = 0; i < 4; ++i, n >>= 8) {
+      code_.push_back(static_cast<unsigned char>(n));
+    }
+  }
+
+  /// \return  position of the value
+  std::size_t imm64(uint64_t n)
+  {
+    auto const pos = code_.size();
+    for (unsigned i = 0; i < 8; ++i, n >>= 8) {
+      code_.push_back(static_cast<unsigned char>(n));
+    }
+    return pos;
+  }
+
+  /// jcc or jmp with a 32 bits displacement
+  void jump(std::initializer_list<unsigned char> opcode, Label label)
+  {
+    bytes(opcode);
+    fixups_.push_back({code_.size(), label});
+    imm32(0);
+  }
+
+  void jmp(Label label) { jump({0xE9}, label); }
+  void je(Label label) { jump({0x0F, 0x84}, label); }
+  void jne(Label label) { jump({0x0F, 0x85}, label); }
+  void jb(Label label) { jump({0x0F, 0x82}, label); }
+  void jbe(Label label) { jump({0x0F, 0x86}, label); }
+
+  /// cmp eax, imm32
+  void cmp_eax(uint32_t n) { bytes({0x3D}); imm32(n); }
+
+  Code && finish()
+  {
+    for (auto & fixup : fixups_) {
+      auto const rel = static_cast<uint32_t>(labels_[fixup.label] - (fixup.pos + 4));
+      std::memcpy(&code_[fixup.pos], &rel, 4);
+    }
+    return std::move(code_);
+  }
+
+private:
+  struct Fixup { std::size_t pos; Label label; };
+
+  Code code_;
+  std::vector<std::size_t> labels_;
+  std::vector<Fixup> fixups_;
+};
+
+struct Compiler
+{
+  using Label = Assembler::Label;
+  using It = Intervals::const_iterator;
+
+  Assembler a;
+  Label ret_true = a.new_label();
+  Label ret_false = a.new_label();
+  std::vector<Label> labels;
+  /// position of the address of escapes in the code, index of range
+  std::vector<std::pair<std::size_t, std::size_t>> escapes_addresses;
+
+  /// rdi: string, eax: character
+  void decode(Range const & rng)
+  {
+    Label decoded = a.new_label();
+    // movzx eax, byte [rdi] ; test eax, eax
+    a.bytes({0x0F, 0xB6, 0x07, 0x85, 0xC0});
+    a.je(rng.states & (Range::Final | Range::Eol) ? ret_true : ret_false);
+    // inc rdi
+    a.bytes({0x48, 0xFF, 0xC7});
+    for (unsigned i = 0; i < 3; ++i) {
+      // movzx ecx, byte [rdi] ; mov edx, ecx ; shr edx, 6 ; cmp edx, 2
+      a.bytes({0x0F, 0xB6, 0x0F, 0x89, 0xCA, 0xC1, 0xEA, 0x06, 0x83, 0xFA, 0x02});
+      a.jne(decoded);
+      // shl eax, 8 ; or eax, ecx ; inc rdi
+      a.bytes({0xC1, 0xE0, 0x08, 0x09, 0xC8, 0x48, 0xFF, 0xC7});
+    }
+    a.bind(decoded);
+  }
+
+  /// rdi += strcspn(rdi, rng.escapes)
+  void skip(std::size_t irng)
+  {
+    // push rdi ; mov rsi, escapes
+    a.bytes({0x57, 0x48, 0xBE});
+    escapes_addresses.emplace_back(a.imm64(0), irng);
+    // mov rax, strcspn ; call rax ; pop rdi ; add rdi, rax
+    a.bytes({0x48, 0xB8});
+    size_t (*f)(char const *, char const *) = &std::strcspn;
+    uint64_t address;
+    std::memcpy(&address, &f, sizeof(address));
+    a.imm64(address);
+    a.bytes({0xFF, 0xD0, 0x5F, 0x48, 0x01, 0xC7});
+  }
+
+  /// jump to the result of a Range::AcceptAll or a Range::Dead
+  bool decided(Range const & rng)
+  {
+    if (rng.hints & Range::AcceptAll) {
+      a.jmp(ret_true);
+      return true;
+    }
+    if (rng.hints & Range::Dead) {
+      a.jmp(ret_false);
+      return true;
+    }
+    return false;
+  }
+
+  /// binary search of eax in [first, last)
+  void tree(It first, It last)
+  {
+    if (first == last) {
+      a.jmp(ret_false);
+      return ;
+    }
+
+    if (last - first == 1) {
+      Event const & e = first->e;
+      if (e.is_char()) {
+        a.cmp_eax(e.l);
+        a.je(labels[first->next]);
+      }
+      else {
+        // lea edx, [rax - l] ; cmp edx, r - l
+        a.bytes({0x8D, 0x90});
+        a.imm32(0u - e.l);
+        a.bytes({0x81, 0xFA});
+        a.imm32(e.r - e.l);
+        a.jbe(labels[first->next]);
+      }
+      a.jmp(ret_false);
+      return ;
+    }
+
+    auto middle = first + (last - first) / 2;
+    Label left = a.new_label();
+    a.cmp_eax(middle->e.l);
+    a.jb(left);
+    tree(middle, last);
+    a.bind(left);
+    tree(first, middle);
+  }
+
+  void compile(Ranges const & rngs)
+  {
+    Intervals intervals;
+
+    for (std::size_t i = 0; i < rngs.size(); ++i) {
+      labels.push_back(a.new_label());
+    }
+
+    // first character: Bol transitions of the first range
+    if (!decided(rngs.front())) {
+      decode(rngs.front());
+      sorted_intervals(intervals, rngs.front(), Transition::Normal | Transition::Bol);
+      tree(intervals.begin(), intervals.end());
+    }
+
+    std::size_t i = 0;
+    for (auto & rng : rngs) {
+      a.bind(labels[i]);
+      if (!decided(rng)) {
+        if (rng.hints & Range::Skip) {
+          skip(i);
+        }
+        decode(rng);
+        sorted_intervals(intervals, rng, Transition::Normal);
+        tree(intervals.begin(), intervals.end());
+      }
+      ++i;
+    }
+
+    // mov eax, 1 ; ret
+    a.bind(ret_true);
+    a.bytes({0xB8, 0x01, 0x00, 0x00, 0x00, 0xC3});
+    // xor eax, eax ; ret
+    a.bind(ret_false);
+    a.bytes({0x31, 0xC0, 0xC3});
+  }
+};
+
+}
+#endif
+
+
+JitMatcher::JitMatcher(const Ranges& rngs)
+{
+#if FALCON_REGEX_DFA_HAS_JIT
+  if (rngs.is_deterministic && !rngs.empty()) {
+    Compiler compiler;
+    compiler.compile(rngs);
+    Code code = compiler.a.finish();
+
+    // escapes after the code
+    std::vector<std::size_t> escapes_pos;
+    for (auto & rng : rngs) {
+      escapes_pos.push_back(code.size());
+      code.insert(code.end(), std::begin(rng.escapes), std::end(rng.escapes));
+    }
+
+    void * p = ::mmap(nullptr, code.size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p != MAP_FAILED) {
+      auto const base = static_cast<unsigned char *>(p);
+      std::memcpy(base, code.data(), code.size());
+      for (auto & x : compiler.escapes_addresses) {
+        auto const address = reinterpret_cast<uint64_t>(base + escapes_pos[x.second]);
+        std::memcpy(base + x.first, &address, sizeof(address));
+      }
+      if (::mprotect(p, code.size(), PROT_READ | PROT_EXEC) == 0) {
+        code_ = p;
+        code_size_ = code.size();
+        std::memcpy(&f_, &p, sizeof(f_));
+        return ;
+      }
+      ::munmap(p, code.size());
+    }
+  }
+#endif
+
+  rngs_ = rngs;
+}
+
+JitMatcher::JitMatcher(JitMatcher&& other) noexcept
+: f_(other.f_)
+, code_(other.code_)
+, code_size_(other.code_size_)
+, rngs_(std::move(other.rngs_))
+{
+  other.f_ = nullptr;
+  other.code_ = nullptr;
+}
+
+JitMatcher& JitMatcher::operator=(JitMatcher&& other) noexcept
+{
+  std::swap(f_, other.f_);
+  std::swap(code_, other.code_);
+  std::swap(code_size_, other.code_size_);
+  std::swap(rngs_, other.rngs_);
+  return *this;
+}
+
+JitMatcher::~JitMatcher()
+{
+#if FALCON_REGEX_DFA_HAS_JIT
+  if (code_) {
+    ::munmap(code_, code_size_);
+  }
+#endif
+}
+
+bool JitMatcher::interpreted(const char* s) const
+{
+  return matches(rngs_, s);
+}
+
+} }
@@ -0,0 +1,44 @@
+#ifndef FALCON_REGEX_DFA_JIT_HPP
+#define FALCON_REGEX_DFA_JIT_HPP
+
+#include "redfa.hpp"
+
+
+namespace falcon { namespace regex_dfa {
+
+/// Native matcher of a deterministic Ranges.
+///
+/// On x86-64 Linux, the ranges become basic blocks of machine code in an
+/// executable mapping and the transitions become a tree of comparisons.
+/// Otherwise (other architecture, non deterministic automaton, mapping
+/// refused by the system or FALCON_REGEX_DFA_DISABLE_JIT), the matcher
+/// uses matches() on a copy of the automaton.
+class JitMatcher
+{
+public:
+  explicit JitMatcher(Ranges const & rngs);
+  JitMatcher(JitMatcher &&) noexcept;
+  JitMatcher & operator = (JitMatcher &&) noexcept;
+  ~JitMatcher();
+
+  /// semantics of matches()
+  bool operator()(char const * s) const
+  {
+    return f_ ? f_(s) : interpreted(s);
+  }
+
+  bool is_native() const { return f_ != nullptr; }
+
+private:
+  bool interpreted(char const * s) const;
+
+  using function_type = bool(*)(char const *);
+  function_type f_ = nullptr;
+  void * code_ = nullptr;
+  std::size_t code_size_ = 0;
+  Ranges rngs_;
+};
+
+} }
+
+#endif
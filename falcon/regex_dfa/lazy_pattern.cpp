@@ -0,0 +1,98 @@
+#include "lazy_pattern.hpp"
+#include "match.hpp"
+
+#include <stdexcept>
+#include <system_error>
+
+
+namespace falcon { namespace regex_dfa {
+
+LazyPattern::LazyPattern(std::string pattern, const ScanOptions& options)
+: pattern_(std::move(pattern))
+, options_(options)
+{}
+
+bool LazyPattern::compile() const noexcept
+{
+  std::call_once(once_, [this]{
+    // the scratch of the scanner is reused by the patterns of a thread
+    thread_local Compiler compiler;
+    try {
+      rngs_ = compiler.scan(pattern_.c_str(), options_);
+    }
+    catch (std::exception const & e) {
+      error_ = e.what();
+      if (error_.empty()) {
+        error_ = "invalid pattern";
+      }
+    }
+    compiled_.store(true, std::memory_order_release);
+  });
+  return error_.empty();
+}
+
+const Ranges& LazyPattern::ranges() const
+{
+  if (!compile()) {
+    throw std::runtime_error(error_);
+  }
+  return rngs_;
+}
+
+bool LazyPattern::operator()(const char* s) const
+{
+  return matches(ranges(), s);
+}
+
+
+BackgroundCompiler::BackgroundCompiler(
+  std::vector<LazyPattern const *> patterns, unsigned nb_threads)
+: patterns_(std::move(patterns))
+, remaining_(patterns_.size())
+{
+  if (!nb_threads) {
+    nb_threads = 1;
+  }
+  threads_.reserve(nb_threads);
+  for (unsigned i = 0; i < nb_threads; ++i) {
+    try {
+      threads_.emplace_back([this]{ run(); });
+    }
+    catch (std::system_error const &) {
+      // fewer threads, no joinable thread is destroyed when none is started
+      if (threads_.empty()) {
+        throw;
+      }
+      break;
+    }
+  }
+}
+
+BackgroundCompiler::~BackgroundCompiler()
+{
+  stop_.store(true, std::memory_order_relaxed);
+  wait();
+}
+
+void BackgroundCompiler::wait()
+{
+  // the other callers wait for the end of the first one
+  std::call_once(joined_, [this]{
+    for (auto & thread : threads_) {
+      thread.join();
+    }
+  });
+}
+
+void BackgroundCompiler::run()
+{
+  std::size_t i;
+  while (!stop_.load(std::memory_order_relaxed)
+    && (i = next_.fetch_add(1, std::memory_order_relaxed)) < patterns_.size()
+  ) {
+    patterns_[i]->compile();
+    remaining_.fetch_sub(1, std::memory_order_release);
+  }
+}
+
+} }
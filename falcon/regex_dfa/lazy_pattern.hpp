@@ -0,0 +1,91 @@
+#ifndef FALCON_REGEX_DFA_LAZY_PATTERN_HPP
+#define FALCON_REGEX_DFA_LAZY_PATTERN_HPP
+
+#include "redfa.hpp"
+#include "scan.hpp"
+
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace falcon { namespace regex_dfa {
+
+/// Pattern scanned on first use.
+///
+/// Concurrent first uses scan the pattern only once, the others wait for
+/// the result. The error of an invalid pattern is kept and thrown on each use.
+class LazyPattern
+{
+public:
+  explicit LazyPattern(std::string pattern, ScanOptions const & options = {});
+
+  LazyPattern(LazyPattern const &) = delete;
+  LazyPattern & operator = (LazyPattern const &) = delete;
+
+  std::string const & pattern() const { return pattern_; }
+  ScanOptions const & options() const { return options_; }
+
+  /// \throw std::runtime_error from scan()
+  Ranges const & ranges() const;
+
+  /// semantics of matches()
+  /// \throw std::runtime_error from scan()
+  bool operator()(char const * s) const;
+
+  /// scan the pattern if needed, without exception
+  /// \return  false for an invalid pattern
+  bool compile() const noexcept;
+
+  /// true when the pattern has been scanned (successfully or not)
+  bool is_compiled() const { return compiled_.load(std::memory_order_acquire); }
+
+private:
+  std::string pattern_;
+  ScanOptions options_;
+  mutable std::once_flag once_;
+  mutable std::atomic<bool> compiled_ {false};
+  mutable Ranges rngs_;
+  mutable std::string error_;
+};
+
+/// Threads compiling a set of LazyPattern in the background.
+///
+/// The patterns must outlive the instance. A pattern used by another thread
+/// in the meantime is not scanned twice. The destructor stops the
+/// compilation and waits for the threads.
+class BackgroundCompiler
+{
+public:
+  explicit BackgroundCompiler(
+    std::vector<LazyPattern const *> patterns,
+    unsigned nb_threads = std::thread::hardware_concurrency()
+  );
+  ~BackgroundCompiler();
+
+  BackgroundCompiler(BackgroundCompiler const &) = delete;
+  BackgroundCompiler & operator = (BackgroundCompiler const &) = delete;
+
+  /// wait for the compilation of every pattern.
+  /// Concurrent calls join the threads only once.
+  void wait();
+
+  /// true when all the patterns are compiled
+  bool done() const { return remaining_.load(std::memory_order_acquire) == 0; }
+
+private:
+  void run();
+
+  std::vector<LazyPattern const *> patterns_;
+  std::atomic<std::size_t> next_ {0};
+  std::atomic<std::size_t> remaining_;
+  std::atomic<bool> stop_ {false};
+  std::vector<std::thread> threads_;
+  std::once_flag joined_;
+};
+
+} }
+
+#endif
@@ -0,0 +1,136 @@
+#include "literal_set.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+
+namespace falcon { namespace regex_dfa {
+
+LiteralSet::LiteralSet(std::vector<std::string> literals)
+: literals_(std::move(literals))
+{
+  std::sort(literals_.begin(), literals_.end(), [](std::string const & a, std::string const & b) {
+    return a.size() < b.size() || (a.size() == b.size() && a < b);
+  });
+  literals_.erase(std::unique(literals_.begin(), literals_.end()), literals_.end());
+
+  std::size_t const max_size = literals_.empty() ? 0 : literals_.back().size();
+  firsts_.resize(max_size + 2);
+  std::size_t i = 0;
+  for (std::size_t n = 0; n <= max_size + 1; ++n) {
+    firsts_[n] = i;
+    while (i < literals_.size() && literals_[i].size() == n) {
+      ++i;
+    }
+  }
+
+  build_automaton();
+}
+
+void LiteralSet::build_automaton()
+{
+  nb_classes_ = 1;
+  for (auto & lit : literals_) {
+    for (char c : lit) {
+      auto & cls = classes_[static_cast<unsigned char>(c)];
+      if (!cls) {
+        cls = static_cast<unsigned char>(nb_classes_++);
+      }
+    }
+  }
+
+  // trie, 0 is a missing child
+  next_.assign(nb_classes_, 0);
+  ends_.assign(1, 0);
+  for (auto & lit : literals_) {
+    std::size_t state = 0;
+    for (char c : lit) {
+      auto const i = state * nb_classes_ + classes_[static_cast<unsigned char>(c)];
+      if (!next_[i]) {
+        next_[i] = static_cast<uint32_t>(ends_.size());
+        ends_.push_back(0);
+        next_.resize(next_.size() + nb_classes_, 0);
+      }
+      state = next_[i];
+    }
+    // sorted by size, the last one is the longest
+    ends_[state] = static_cast<uint32_t>(lit.size() + 1);
+  }
+
+  // breadth first: the missing children take the transitions of the
+  // failure link, which is already complete
+  std::vector<uint32_t> fails(ends_.size(), 0);
+  std::vector<uint32_t> queue;
+  for (std::size_t c = 0; c < nb_classes_; ++c) {
+    if (next_[c]) {
+      queue.push_back(next_[c]);
+    }
+  }
+  for (std::size_t iq = 0; iq < queue.size(); ++iq) {
+    auto const state = queue[iq];
+    auto const fail = fails[state];
+    if (!ends_[state]) {
+      ends_[state] = ends_[fail];
+    }
+    for (std::size_t c = 0; c < nb_classes_; ++c) {
+      auto & child = next_[state * nb_classes_ + c];
+      auto const fail_next = next_[fail * nb_classes_ + c];
+      if (child) {
+        fails[child] = fail_next;
+        queue.push_back(child);
+      }
+      else {
+        child = fail_next;
+      }
+    }
+  }
+}
+
+bool LiteralSet::operator()(const char* s) const
+{
+  // a size greater than the longest literal is enough to reject s,
+  // nothing is read after the nul
+  std::size_t const max_size = firsts_.empty() ? 0 : firsts_.size() - 1u;
+  std::size_t size = 0;
+  while (size < max_size && s[size]) {
+    ++size;
+  }
+  return (*this)(s, size);
+}
+
+bool LiteralSet::search(const char* s, const char*& match_first, const char*& match_last) const
+{
+  if (ends_.empty()) {
+    return false;
+  }
+
+  // the empty literal is at the beginning
+  uint32_t state = 0;
+  const char* p = s;
+  while (!ends_[state]) {
+    if (!*p) {
+      return false;
+    }
+    state = next_[state * nb_classes_ + classes_[static_cast<unsigned char>(*p)]];
+    ++p;
+  }
+
+  match_last = p;
+  match_first = p - (ends_[state] - 1);
+  return true;
+}
+
+bool LiteralSet::operator()(const char* s, std::size_t size) const
+{
+  if (size + 1u >= firsts_.size()) {
+    return false;
+  }
+  auto const first = literals_.begin() + static_cast<std::ptrdiff_t>(firsts_[size]);
+  auto const last = literals_.begin() + static_cast<std::ptrdiff_t>(firsts_[size + 1]);
+  auto const it = std::lower_bound(first, last, s, [size](std::string const & lit, char const * s) {
+    return std::memcmp(lit.data(), s, size) < 0;
+  });
+  return it != last && !std::memcmp(it->data(), s, size);
+}
+
+} }
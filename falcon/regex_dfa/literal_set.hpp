@@ -0,0 +1,54 @@
+#ifndef FALCON_REGEX_DFA_LITERAL_SET_HPP
+#define FALCON_REGEX_DFA_LITERAL_SET_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+
+namespace falcon { namespace regex_dfa {
+
+/// Whole string matcher of a finite set of literals.
+///
+/// The literals are grouped by size and sorted, a string is compared with
+/// memcmp() to the literals of its size only.
+/// search() runs an Aho-Corasick automaton of the literals on the bytes
+/// of a string.
+class LiteralSet
+{
+public:
+  LiteralSet() = default;
+
+  explicit LiteralSet(std::vector<std::string> literals);
+
+  /// s is one of the literals
+  bool operator()(char const * s) const;
+  /// s[size] is the end of the string
+  bool operator()(char const * s, std::size_t size) const;
+
+  /// \return  false when no literal is in s, otherwise [match_first, match_last)
+  ///   is the first literal to end, the longest of those ending there
+  bool search(char const * s, char const * & match_first, char const * & match_last) const;
+
+  std::vector<std::string> const & literals() const { return literals_; }
+
+private:
+  void build_automaton();
+
+  /// sorted by size then by bytes
+  std::vector<std::string> literals_;
+  /// literals of size n are in [firsts_[n], firsts_[n+1])
+  std::vector<std::size_t> firsts_;
+
+  /// bytes of the literals, 0 for the others
+  unsigned char classes_[256] {};
+  std::size_t nb_classes_ = 0;
+  /// next state of (state * nb_classes_ + class), 0 is the root
+  std::vector<uint32_t> next_;
+  /// by state: 1 + size of the longest literal that ends there, 0 for none
+  std::vector<uint32_t> ends_;
+};
+
+} }
+
+#endif
@@ -1,70 +1,145 @@
 #include "match.hpp"
 #include "redfa.hpp"
+#include "flat_ranges.hpp"
+#include "heatmap.hpp"
 #include "regex_consumer.hpp"
+#include "stats.hpp"
 #include "trace.hpp"
 
 #include <memory>
+#include <cstring>
+#include <algorithm>
 
 
 namespace falcon { namespace regex_dfa {
 
-bool match(const Ranges& rngs, const char* s)
+namespace {
+
+thread_local MatchStats stats {};
+
+/// jump to the next character that can leave a Range::Skip
+template<class Rng>
+void skip(utf8_consumer & consumer, Rng const & rng)
+{
+  if (rng.hints & Range::Skip) {
+    auto const n = std::strcspn(consumer.str(), rng.escapes);
+    FALCON_REGEX_DFA_STATS(stats.skipped_bytes += n);
+    consumer.str(consumer.str() + n);
+  }
+}
+
+/// the result is known in a Range::AcceptAll or a Range::Dead
+template<class Rng>
+bool is_decided(Rng const & rng)
+{
+  return bool(rng.hints & (Range::AcceptAll | Range::Dead));
+}
+
+void trace_range(Ranges const & rngs, std::size_t i)
+{
+  FALCON_REGEX_DFA_TRACE(print_automaton(rngs[i], int(i)));
+  (void)rngs;
+  (void)i;
+}
+
+void trace_range(FlatRanges const &, std::size_t i)
+{
+  FALCON_REGEX_DFA_TRACE_VAR2(range, i);
+  (void)i;
+}
+
+struct NoProfile
+{
+  void enter(std::size_t) const {}
+  void test(std::size_t) const {}
+};
+
+struct HeatmapProfile
+{
+  Heatmap & heatmap;
+
+  void enter(std::size_t i) const { ++heatmap.entered[i]; }
+  void test(std::size_t i) const { ++heatmap.tested[i]; }
+};
+
+/// Rngs is Ranges or FlatRanges
+template<class Rngs, class Profile = NoProfile>
+bool basic_match(const Rngs& rngs, const char* s, Profile profile = {})
 {
   if (rngs.empty()) {
     return true;
   }
 
   FALCON_REGEX_DFA_TRACE(std::cerr << "# match:\n");
+  FALCON_REGEX_DFA_STATS(++stats.calls);
 
   std::size_t i = 0;
   utf8_consumer consumer(s);
-  char_int c;
-  bool final;
-  while (
-      !(final = bool(rngs[i].states & Range::Final))
-    && (c = consumer.bumpc())
-    //&& (rngs[i].states & Range::Normal)
-    && ([&]() -> bool {
-      FALCON_REGEX_DFA_TRACE(std::cerr << "--- " << utf8_char(c) << " ---\n");
-      FALCON_REGEX_DFA_TRACE(print_automaton(rngs[i], int(i)));
-      for (auto && t : rngs[i].transitions) {
-        if (t.e.contains(c)) {
-          i = t.next;
-          return true;
-        }
+  char_int c = 0;
+
+  auto next = [&](Transition::State states) -> bool {
+    FALCON_REGEX_DFA_TRACE(std::cerr << "--- " << utf8_char(c) << " ---\n");
+    trace_range(rngs, i);
+    FALCON_REGEX_DFA_STATS(++stats.characters);
+    for (auto && t : rngs[i].transitions) {
+      FALCON_REGEX_DFA_STATS(++stats.transitions_examined);
+      profile.test(i);
+      if (bool(t.states & states) && t.e.contains(c)) {
+        FALCON_REGEX_DFA_STATS(++stats.states_entered);
+        i = t.next;
+        profile.enter(i);
+        return true;
       }
-      return false;
-    }())
-  );
+    }
+    return false;
+  };
+
+  profile.enter(0);
+  if (!is_decided(rngs[0]) && (c = consumer.bumpc()) && next(Transition::Normal | Transition::Bol)) {
+    while (!is_decided(rngs[i])
+      && (skip(consumer, rngs[i]), (c = consumer.bumpc()))
+      && next(Transition::Normal)
+    ) {
+    }
+  }
+
+  if (rngs[i].hints & Range::AcceptAll) {
+    FALCON_REGEX_DFA_STATS(stats.early_accepts += bool(consumer.getc()));
+    return true;
+  }
 
   FALCON_REGEX_DFA_TRACE(std::cerr
-    << "final: " << final
+    << "final: " << bool(rngs[i].states & Range::Final)
     << "\nc: " << c
     << "\nend: " << bool(rngs[i].states & Range::Eol)
     << "\n"
   );
-  return final || (!c && bool(rngs[i].states & Range::Eol));
+  FALCON_REGEX_DFA_STATS(stats.early_exits += bool(c));
+  return !c && bool(rngs[i].states & (Range::Final | Range::Eol));
 }
 
 
-bool nfa_match(const Ranges& rngs, const char* s)
+template<class Rngs, class Profile = NoProfile>
+bool basic_nfa_match(const Rngs& rngs, const char* s, Profile profile = {})
 {
   if (rngs.empty()) {
     return true;
   }
 
   FALCON_REGEX_DFA_TRACE(std::cerr << "# nfa_match:\n");
+  FALCON_REGEX_DFA_STATS(++stats.calls);
 
   struct DynArray {
-    using value_type = Range const *;
-    std::unique_ptr<value_type> a;
+    using value_type = std::size_t;
+    std::unique_ptr<value_type[]> a;
     value_type * p;
 
     DynArray(std::size_t sz): a(new value_type[sz]), p(a.get()) {}
 
     value_type * begin() const { return a.get(); }
     value_type * end() const { return p; }
-    void push_back(Range const & rng) { *p = &rng; ++p; }
+    std::size_t size() const { return std::size_t(p - a.get()); }
+    void push_back(std::size_t i) { *p = i; ++p; }
     bool empty() const { return p == a.get(); }
     void clear() { p = a.get(); }
   };
@@ -73,23 +148,41 @@ bool nfa_match(const Ranges& rngs, const char* s)
   DynArray t1(rngs.size());
   DynArray t2(rngs.size());
 
-  t1.push_back(rngs.front());
+  t1.push_back(0);
+  profile.enter(0);
 
   unsigned auto_increment = 1;
   utf8_consumer consumer(s);
-  char_int c;
+  char_int c = 0;
+  bool is_accepted = bool(rngs[0].hints & Range::AcceptAll);
+
+  if (rngs[0].hints & Range::Dead) {
+    t1.clear();
+  }
 
   auto next = [&](Transition::State states){
-    for (Range const * prng : t1) {
+    FALCON_REGEX_DFA_STATS(++stats.characters);
+    for (std::size_t i : t1) {
       FALCON_REGEX_DFA_TRACE(std::cerr << "--- " << utf8_char(c) << " ---\n");
-      FALCON_REGEX_DFA_TRACE(print_automaton(*prng, int(prng-&rngs.front())));
-      for (auto && t : prng->transitions) {
+      trace_range(rngs, i);
+      for (auto && t : rngs[i].transitions) {
+        FALCON_REGEX_DFA_STATS(++stats.transitions_examined);
+        profile.test(i);
         if (bool(t.states & states)
          && t.e.contains(c)
          && crossing_table[t.next] < auto_increment
         ) {
-          t2.push_back(rngs[t.next]);
+          FALCON_REGEX_DFA_STATS(++stats.states_entered);
+          profile.enter(t.next);
           crossing_table[t.next] = auto_increment;
+          auto const hints = rngs[t.next].hints;
+          if (hints & Range::AcceptAll) {
+            is_accepted = true;
+          }
+          // a Range::Dead never leads to a final range
+          else if (!(hints & Range::Dead)) {
+            t2.push_back(t.next);
+          }
         }
       }
     }
@@ -98,19 +191,28 @@ bool nfa_match(const Ranges& rngs, const char* s)
     swap(t1, t2);
     t2.clear();
     ++auto_increment;
+    FALCON_REGEX_DFA_STATS(stats.peak_active_states = std::max<uint64_t>(stats.peak_active_states, t1.size()));
   };
 
-  if ((c = consumer.bumpc()) && !t1.empty()) {
+  if (!is_accepted && (c = consumer.bumpc()) && !t1.empty()) {
     next(Transition::Normal | Transition::Bol);
 
-    while ((c = consumer.bumpc()) && !t1.empty()) {
+    while (!is_accepted && (
+      (t1.size() == 1 ? skip(consumer, rngs[*t1.begin()]) : void())
+    , (c = consumer.bumpc()) && !t1.empty()
+    )) {
       next(Transition::Normal);
     };
   }
 
-  auto has_state = [&t1](Range::State e) {
-    for (Range const * prng : t1) {
-      if (bool(prng->states & e)) {
+  if (is_accepted) {
+    FALCON_REGEX_DFA_STATS(stats.early_accepts += bool(consumer.getc()));
+    return true;
+  }
+
+  auto has_state = [&rngs, &t1](Range::State e) {
+    for (std::size_t i : t1) {
+      if (bool(rngs[i].states & e)) {
         return true;
       }
     }
@@ -122,8 +224,74 @@ bool nfa_match(const Ranges& rngs, const char* s)
     << "\nc: " << c
     << "\n"
   );
+  FALCON_REGEX_DFA_STATS(stats.early_exits += bool(c));
   return (!c && has_state(Range::Final | Range::Eol));
 }
 
+}
+
+
+MatchStats const & match_stats()
+{
+  return stats;
+}
+
+void reset_match_stats()
+{
+  stats = MatchStats{};
+}
+
+bool has_match_stats()
+{
+#if defined(FALCON_REGEX_DFA_ENABLE_STATS) && FALCON_REGEX_DFA_ENABLE_STATS != 0
+  return true;
+#else
+  return false;
+#endif
+}
+
+
+bool match(const Ranges& rngs, const char* s)
+{
+  return basic_match(rngs, s);
+}
+
+bool nfa_match(const Ranges& rngs, const char* s)
+{
+  return basic_nfa_match(rngs, s);
+}
+
+bool matches(const Ranges& rngs, const char* s)
+{
+  return rngs.is_deterministic ? match(rngs, s) : nfa_match(rngs, s);
+}
+
+
+bool profile_matches(const Ranges& rngs, const char* s, Heatmap& heatmap)
+{
+  heatmap.entered.resize(rngs.size());
+  heatmap.tested.resize(rngs.size());
+  HeatmapProfile const profile{heatmap};
+  return rngs.is_deterministic
+    ? basic_match(rngs, s, profile)
+    : basic_nfa_match(rngs, s, profile);
+}
+
+
+bool match(const FlatRanges& rngs, const char* s)
+{
+  return basic_match(rngs, s);
+}
+
+bool nfa_match(const FlatRanges& rngs, const char* s)
+{
+  return basic_nfa_match(rngs, s);
+}
+
+bool matches(const FlatRanges& rngs, const char* s)
+{
+  return rngs.is_deterministic ? match(rngs, s) : nfa_match(rngs, s);
+}
+
 
 } }
@@ -4,10 +4,19 @@
 namespace falcon { namespace regex_dfa {
 
 class Ranges;
+class FlatRanges;
 
+/// \pre  rngs.is_deterministic
 bool match(Ranges const & rngs, char const * s);
 bool nfa_match(Ranges const & rngs, char const * s);
 
+/// use match() when rngs is deterministic, otherwise nfa_match()
+bool matches(Ranges const & rngs, char const * s);
+
+bool match(FlatRanges const & rngs, char const * s);
+bool nfa_match(FlatRanges const & rngs, char const * s);
+bool matches(FlatRanges const & rngs, char const * s);
+
 } }
 
-#endif
\ No newline at end of file
+#endif
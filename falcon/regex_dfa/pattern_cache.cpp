@@ -0,0 +1,173 @@
+#include "pattern_cache.hpp"
+
+#include <unordered_map>
+#include <shared_mutex>
+#include <mutex>
+#include <atomic>
+#include <list>
+
+
+namespace falcon { namespace regex_dfa {
+
+std::size_t memory_size(const Ranges& rngs)
+{
+  std::size_t n
+    = sizeof(Ranges)
+    + rngs.capacity() * sizeof(Range)
+    + rngs.capture_table.capacity() * sizeof(unsigned);
+  for (auto & rng : rngs) {
+    n += rng.transitions.capacity() * sizeof(Transition)
+       + rng.capstates.capacity() * sizeof(Capture);
+  }
+  return n;
+}
+
+
+struct PatternCache::Shard
+{
+  struct Entry
+  {
+    Entry(std::string const * key, value_type rngs, std::size_t bytes)
+    : key(key), rngs(std::move(rngs)), bytes(bytes)
+    {}
+
+    /// options_bits() then pattern
+    std::string const * key;
+    value_type rngs;
+    std::size_t bytes;
+    /// set by a hit, cleared by the clock hand
+    std::atomic<bool> referenced {false};
+  };
+
+  using Clock = std::list<Entry>;
+
+  /// shared by the hits, exclusive for the modifications
+  std::shared_timed_mutex mutex;
+  /// a new entry is inserted before the hand, thus visited last
+  Clock clock;
+  Clock::iterator hand = clock.end();
+  std::unordered_map<std::string, Clock::iterator> map;
+  std::size_t bytes = 0;
+
+  std::atomic<uint64_t> hits {0};
+  std::atomic<uint64_t> misses {0};
+  std::atomic<uint64_t> evictions {0};
+
+  static value_type const & touch(Entry & e)
+  {
+    // avoid a write on the shared cache line when already referenced
+    if (!e.referenced.load(std::memory_order_relaxed)) {
+      e.referenced.store(true, std::memory_order_relaxed);
+    }
+    return e.rngs;
+  }
+
+  /// evict the first entry not referenced since the last turn, except \p used
+  void evict_one(Clock::iterator used)
+  {
+    for (;;) {
+      if (hand == clock.end()) {
+        hand = clock.begin();
+      }
+      if (hand == used || hand->referenced.exchange(false, std::memory_order_relaxed)) {
+        ++hand;
+        continue;
+      }
+      bytes -= hand->bytes;
+      map.erase(map.find(*hand->key));
+      hand = clock.erase(hand);
+      ++evictions;
+      return;
+    }
+  }
+};
+
+PatternCache::PatternCache(std::size_t max_bytes, unsigned nb_shards)
+: shards_(new Shard[nb_shards ? nb_shards : 1])
+, nb_shards_(nb_shards ? nb_shards : 1)
+, max_shard_bytes_(max_bytes / nb_shards_)
+{}
+
+PatternCache::~PatternCache() = default;
+
+PatternCache::value_type PatternCache::get(const std::string& pattern, const ScanOptions& options)
+{
+  std::string key(1, char(options_bits(options)));
+  key += pattern;
+
+  Shard & shard = shards_[std::hash<std::string>()(key) % nb_shards_];
+
+  {
+    std::shared_lock<std::shared_timed_mutex> lock(shard.mutex);
+    auto it = shard.map.find(key);
+    if (it != shard.map.end()) {
+      ++shard.hits;
+      return Shard::touch(*it->second);
+    }
+  }
+
+  ++shard.misses;
+  auto rngs = std::make_shared<Ranges const>(scan(pattern.c_str(), options));
+  auto const bytes = memory_size(*rngs) + key.size();
+
+  std::lock_guard<std::shared_timed_mutex> lock(shard.mutex);
+  auto p = shard.map.emplace(std::move(key), shard.clock.end());
+  if (!p.second) {
+    // scanned by another thread in the meantime
+    return Shard::touch(*p.first->second);
+  }
+
+  auto e = shard.clock.emplace(shard.hand, &p.first->first, rngs, bytes);
+  p.first->second = e;
+  shard.bytes += bytes;
+
+  while (shard.bytes > max_shard_bytes_ && shard.clock.size() > 1) {
+    shard.evict_one(e);
+  }
+
+  return rngs;
+}
+
+std::size_t PatternCache::size() const
+{
+  std::size_t n = 0;
+  for (unsigned i = 0; i < nb_shards_; ++i) {
+    std::shared_lock<std::shared_timed_mutex> lock(shards_[i].mutex);
+    n += shards_[i].clock.size();
+  }
+  return n;
+}
+
+std::size_t PatternCache::bytes() const
+{
+  std::size_t n = 0;
+  for (unsigned i = 0; i < nb_shards_; ++i) {
+    std::shared_lock<std::shared_timed_mutex> lock(shards_[i].mutex);
+    n += shards_[i].bytes;
+  }
+  return n;
+}
+
+PatternCache::Stats PatternCache::stats() const
+{
+  Stats stats {0, 0, 0};
+  for (unsigned i = 0; i < nb_shards_; ++i) {
+    stats.hits += shards_[i].hits;
+    stats.misses += shards_[i].misses;
+    stats.evictions += shards_[i].evictions;
+  }
+  return stats;
+}
+
+void PatternCache::clear()
+{
+  for (unsigned i = 0; i < nb_shards_; ++i) {
+    std::lock_guard<std::shared_timed_mutex> lock(shards_[i].mutex);
+    shards_[i].map.clear();
+    shards_[i].clock.clear();
+    shards_[i].hand = shards_[i].clock.end();
+    shards_[i].bytes = 0;
+  }
+}
+
+} }
@@ -0,0 +1,64 @@
+#ifndef FALCON_REGEX_DFA_PATTERN_CACHE_HPP
+#define FALCON_REGEX_DFA_PATTERN_CACHE_HPP
+
+#include "redfa.hpp"
+#include "scan.hpp"
+
+#include <memory>
+#include <string>
+#include <cstdint>
+
+
+namespace falcon { namespace regex_dfa {
+
+/// \return  approximate number of bytes used by rngs
+std::size_t memory_size(Ranges const & rngs);
+
+/// Thread safe cache of scan().
+///
+/// A pattern is cached by options. Patterns are spread over shards bounded
+/// by max_bytes / nb_shards (see memory_size()).
+/// A hit only takes a shared lock and marks the pattern as referenced, the
+/// eviction is a clock (second chance) approximation of a LRU.
+/// A pattern is scanned without lock, then the first inserted Ranges wins.
+class PatternCache
+{
+public:
+  using value_type = std::shared_ptr<Ranges const>;
+
+  struct Stats
+  {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+  };
+
+  explicit PatternCache(std::size_t max_bytes, unsigned nb_shards = 16);
+  ~PatternCache();
+
+  PatternCache(PatternCache const &) = delete;
+  PatternCache & operator = (PatternCache const &) = delete;
+
+  /// \throw std::runtime_error from scan()
+  value_type get(std::string const & pattern, ScanOptions const & options = {});
+
+  /// number of patterns in the cache
+  std::size_t size() const;
+  /// sum of memory_size() of the patterns in the cache
+  std::size_t bytes() const;
+
+  Stats stats() const;
+
+  void clear();
+
+private:
+  struct Shard;
+
+  std::unique_ptr<Shard[]> shards_;
+  unsigned nb_shards_;
+  std::size_t max_shard_bytes_;
+};
+
+} }
+
+#endif
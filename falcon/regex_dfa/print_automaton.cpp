@@ -1,11 +1,17 @@
 #include "range_iterator.hpp"
 #include "print_automaton.hpp"
 #include "redfa.hpp"
+#include "heatmap.hpp"
+#include "regex_consumer.hpp"
 
 #include <algorithm>
 #include <iostream>
 #include <iomanip>
+#include <ostream>
+#include <map>
+#include <string>
 #include <cassert>
+#include <cstdio>
 
 namespace {
   constexpr char const * colors[]{
@@ -88,7 +94,7 @@ std::ostream & operator<<(std::ostream & os, Capture const & capstate) {
   return os << c[capstate.e] << capstate.n << " ";
 }
 
-void print_head_rng(const Range& rng, int num)
+void print_head_rng(const Range& rng, int num, Heatmap const * heatmap = nullptr)
 {
   std::cout
     << std::setw(4) << num
@@ -99,6 +105,27 @@ void print_head_rng(const Range& rng, int num)
   for (auto & capstate : rng.capstates) {
     std::cout << capstate;
   }
+  if (rng.hints & Range::Skip) {
+    std::cout << colors[5] << " skip[";
+    for (char const * p = rng.escapes; *p; ++p) {
+      std::cout << *p;
+    }
+    std::cout << "]";
+  }
+  if (rng.hints & Range::AcceptAll) {
+    std::cout << colors[5] << " accept-all";
+  }
+  if (rng.hints & Range::Dead) {
+    std::cout << colors[5] << " dead";
+  }
+  if (heatmap) {
+    auto const i = std::size_t(num);
+    std::cout
+      << colors[0]
+      << " entered: " << (i < heatmap->entered.size() ? heatmap->entered[i] : 0)
+      << " tested: " << (i < heatmap->tested.size() ? heatmap->tested[i] : 0)
+    ;
+  }
   std::cout << reset_color;
 }
 
@@ -138,7 +165,9 @@ struct RBegin {
   template<class Cont> static auto end(Cont & cont) { using std::rend; return rend(cont); }
 };
 
-void print_automaton(const Ranges& rngs)
+namespace {
+
+void print_ranges(const Ranges& rngs, Heatmap const * heatmap)
 {
   auto sz = rngs.size() * 2u;
   for (auto & rng : rngs) {
@@ -290,7 +319,7 @@ void print_automaton(const Ranges& rngs)
   for (auto & rng : rngs) {
     print_tree();
     std::cout << " ";
-    print_head_rng(rng, int(&rng-&rngs[0]));
+    print_head_rng(rng, int(&rng-&rngs[0]), heatmap);
     std::cout << "\n";
     for (auto & t : rng.transitions) {
       print_tree();
@@ -303,4 +332,113 @@ void print_automaton(const Ranges& rngs)
   print_table(rngs.capture_table);
 }
 
+void print_dot_char(std::ostream & out, char_int c)
+{
+  if (c == ~char_int{}) {
+    out << "max";
+  }
+  else if (c == '"' || c == '\\') {
+    out << '\\' << char(c);
+  }
+  else if (c > ' ' && c < 0x7f) {
+    out << char(c);
+  }
+  else if (c > 0x7f) {
+    out << utf8_char(c);
+  }
+  else {
+    out << "\\\\x" << std::hex << std::setw(2) << std::setfill('0') << c
+      << std::dec << std::setfill(' ');
+  }
+}
+
+}
+
+void print_automaton(const Ranges& rngs)
+{
+  print_ranges(rngs, nullptr);
+}
+
+void print_automaton(const Ranges& rngs, const Heatmap& heatmap)
+{
+  print_ranges(rngs, &heatmap);
+}
+
+void print_dot(std::ostream& out, const Ranges& rngs, Heatmap const * heatmap)
+{
+  uint64_t max_heat = 0;
+  if (heatmap) {
+    for (auto n : heatmap->tested) {
+      max_heat = std::max(max_heat, n);
+    }
+  }
+
+  out
+    << "digraph regex_dfa {\n"
+       "  rankdir=LR;\n"
+       "  node [shape=circle, style=filled, fillcolor=white];\n"
+       "  start [shape=point];\n"
+  ;
+  if (!rngs.empty()) {
+    out << "  start -> 0;\n";
+  }
+
+  std::size_t i = 0;
+  for (auto & rng : rngs) {
+    out << "  " << i << " [label=\"" << i;
+    if (rng.hints & Range::Skip) {
+      out << "\\nskip";
+    }
+    if (rng.hints & Range::AcceptAll) {
+      out << "\\naccept-all";
+    }
+    if (rng.hints & Range::Dead) {
+      out << "\\ndead";
+    }
+    std::string color = "white";
+    if (heatmap && i < heatmap->tested.size() && i < heatmap->entered.size()) {
+      out
+        << "\\nentered: " << heatmap->entered[i]
+        << "\\ntested: " << heatmap->tested[i];
+      if (max_heat) {
+        // white to red
+        char hsv[32];
+        std::snprintf(hsv, sizeof(hsv), "0.000 %.3f 1.000", double(heatmap->tested[i]) / double(max_heat));
+        color = hsv;
+      }
+    }
+    out << "\"";
+    if (rng.states & (Range::Final | Range::Eol)) {
+      out << ", shape=doublecircle";
+    }
+    out << ", fillcolor=\"" << color << "\"];\n";
+
+    // one edge by destination
+    std::map<std::size_t, std::vector<Transition const *>> edges;
+    for (auto & t : rng.transitions) {
+      edges[t.next].push_back(&t);
+    }
+    for (auto & edge : edges) {
+      out << "  " << i << " -> " << edge.first << " [label=\"";
+      char const * sep = "";
+      for (auto * t : edge.second) {
+        out << sep;
+        if (t->states & Transition::Bol) {
+          out << (t->states & Transition::Normal ? "" : "^");
+        }
+        print_dot_char(out, t->e.l);
+        if (t->e.l != t->e.r) {
+          out << '-';
+          print_dot_char(out, t->e.r);
+        }
+        sep = " ";
+      }
+      out << "\"];\n";
+    }
+    ++i;
+  }
+
+  out << "}\n";
+}
+
 } }
@@ -1,16 +1,25 @@
 #ifndef FALCON_REGEX_DFA_PRINT_AUTOMATON_HPP
 #define FALCON_REGEX_DFA_PRINT_AUTOMATON_HPP
 
+#include <iosfwd>
+
 namespace falcon { namespace regex_dfa {
   class Range;
   class Ranges;
   class Transition;
   class Transitions;
+  struct Heatmap;
 
   void print_automaton(Ranges const &);
+  /// with the visits of each range
+  void print_automaton(Ranges const &, Heatmap const &);
   void print_automaton(Range const &, int num = -1);
   void print_automaton(Transitions const &);
   void print_automaton(Transition const &);
+
+  /// Graphviz graph of the automaton.
+  /// With a heatmap, the nodes are colored by the number of tested transitions.
+  void print_dot(std::ostream & out, Ranges const &, Heatmap const * heatmap = nullptr);
 } }
 
 #endif
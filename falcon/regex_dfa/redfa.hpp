@@ -24,7 +24,7 @@ struct Event
         && r == other.r;
   }
 
-  bool contains(char_int c) const noexcept {
+  constexpr bool contains(char_int c) const noexcept {
     return l <= c && c <= r;
   }
 };
@@ -147,6 +147,20 @@ struct Range {
   Captures capstates;
   Transitions transitions;
 
+  /// computed from transitions after scan(), not part of the comparison
+  enum Hint {
+    NoHint = 0,
+    /// loops on itself for every character except escapes (see skip_states.hpp)
+    Skip = 1 << 0,
+    /// final whatever the following characters (see decided_states.hpp)
+    AcceptAll = 1 << 1,
+    /// never reaches a final range (see decided_states.hpp)
+    Dead = 1 << 2,
+  };
+  Hint hints = NoHint;
+  /// bytes that leave a Skip range, nul terminated
+  char escapes[4] = {};
+
   bool operator == (Range const & other) const {
     return states == other.states
         && capstates == other.capstates
@@ -176,11 +190,26 @@ inline Range::State operator ~ (Range::State a) {
   return static_cast<Range::State>(~int(a) & (Range::INC_LAST_FLAG * 2 - 3));
 }
 
+inline Range::Hint operator | (Range::Hint a, Range::Hint b) {
+  return static_cast<Range::Hint>(int(a) | b);
+}
+
+inline Range::Hint & operator |= (Range::Hint & a, Range::Hint b) {
+  a = static_cast<Range::Hint>(a | b);
+  return a;
+}
+
+inline Range::Hint operator & (Range::Hint a, Range::Hint b) {
+  return static_cast<Range::Hint>(int(a) & b);
+}
+
 struct Ranges : std::vector<Range>
 {
   using std::vector<Range>::vector;
   using std::vector<Range>::operator=;
   std::vector<unsigned> capture_table;
+  /// at most one transition for each character (see deterministic.hpp)
+  bool is_deterministic = false;
 };
 
 template<class T>
@@ -0,0 +1,133 @@
+#include "regex.hpp"
+#include "scan.hpp"
+#include "match.hpp"
+#include "factorize.hpp"
+
+#include <cstring>
+#include <algorithm>
+
+
+namespace falcon { namespace regex_dfa {
+
+namespace {
+
+Ranges factorized(Ranges rngs)
+{
+  factorize(rngs);
+  return rngs;
+}
+
+bool has_anchor(Ranges const & rngs)
+{
+  return std::any_of(rngs.begin(), rngs.end(), [](Range const & rng) {
+    return (rng.states & (Range::Bol | Range::Eol))
+      || std::any_of(rng.transitions.begin(), rng.transitions.end(), [](Transition const & t) {
+        return bool(t.states & Transition::Bol);
+      });
+  });
+}
+
+}
+
+Regex::Regex(const char* pattern, ScanOptions const & options)
+: Regex(scan(pattern, options))
+{}
+
+Regex::Regex(Ranges rngs)
+: rngs_(factorized(std::move(rngs)))
+, analysis_(analyze(rngs_))
+, first_bytes_(rngs_)
+, reversed_(reverse(rngs_))
+, is_suffix_search_(
+    std::none_of(rngs_.begin(), rngs_.end(), [](Range const & rng) {
+      return bool(rng.states & Range::Final);
+    })
+    && std::any_of(rngs_.begin(), rngs_.end(), [](Range const & rng) {
+      return bool(rng.states & Range::Eol);
+    }))
+{
+  if (analysis_.is_literal) {
+    engine_ = Engine::Literal;
+  }
+  else if (!analysis_.literals.empty()) {
+    engine_ = Engine::LiteralSet;
+    literal_set_ = LiteralSet(analysis_.literals);
+  }
+  else if (rngs_.is_deterministic) {
+    engine_ = Engine::Dfa;
+  }
+  else if (rngs_.size() <= BitParallelMatcher::max_states
+    && BitParallelMatcher::tables_size(rngs_) <= max_bit_parallel_size
+  ) {
+    engine_ = Engine::BitParallel;
+    bit_parallel_ = BitParallelMatcher(rngs_);
+  }
+  else {
+    engine_ = Engine::Nfa;
+  }
+
+  // without anchor, the accepted substrings are the literals
+  is_literal_search_ = engine_ == Engine::LiteralSet && !has_anchor(rngs_);
+}
+
+bool Regex::operator()(const char* s) const
+{
+  switch (engine_) {
+    case Engine::Literal: return !std::strcmp(s, analysis_.literal.c_str());
+    case Engine::LiteralSet: return literal_set_(s);
+    case Engine::Dfa: return match(rngs_, s);
+    case Engine::BitParallel: return bit_parallel_(s);
+    case Engine::Nfa: break;
+  }
+  return nfa_match(rngs_, s);
+}
+
+bool Regex::operator()(const char* s, std::size_t size) const
+{
+  if (!is_accepted_size(analysis_, size)) {
+    return false;
+  }
+  if (engine_ == Engine::Literal) {
+    // same size
+    return !std::memcmp(s, analysis_.literal.data(), size);
+  }
+  if (engine_ == Engine::LiteralSet) {
+    return literal_set_(s, size);
+  }
+  return (*this)(s);
+}
+
+bool Regex::search(const char* s) const
+{
+  if (is_literal_search_) {
+    const char* match_first;
+    const char* match_last;
+    return literal_set_.search(s, match_first, match_last);
+  }
+  if (is_suffix_search_) {
+    return search_suffix(reversed_, s);
+  }
+  return regex_dfa::search(rngs_, first_bytes_, s);
+}
+
+bool Regex::search(const char* s, const char*& match_first, const char*& match_last) const
+{
+  if (is_literal_search_) {
+    return literal_set_.search(s, match_first, match_last);
+  }
+  return regex_dfa::search(rngs_, first_bytes_, reversed_, s, match_first, match_last);
+}
+
+char const * to_string(Regex::Engine engine)
+{
+  switch (engine) {
+    case Regex::Engine::Literal: return "literal";
+    case Regex::Engine::LiteralSet: return "literal-set";
+    case Regex::Engine::Dfa: return "dfa";
+    case Regex::Engine::BitParallel: return "bit-parallel";
+    case Regex::Engine::Nfa: break;
+  }
+  return "nfa";
+}
+
+} }
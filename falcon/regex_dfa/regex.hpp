@@ -0,0 +1,73 @@
+#ifndef FALCON_REGEX_DFA_REGEX_HPP
+#define FALCON_REGEX_DFA_REGEX_HPP
+
+#include "redfa.hpp"
+#include "scan.hpp"
+#include "analysis.hpp"
+#include "bit_parallel.hpp"
+#include "literal_set.hpp"
+#include "search.hpp"
+#include "reverse.hpp"
+
+
+namespace falcon { namespace regex_dfa {
+
+/// A pattern with the cheapest matcher chosen from its analysis():
+/// - Literal: strcmp() with the only accepted string;
+/// - LiteralSet: LiteralSet of a small finite set of accepted strings;
+/// - Dfa: match() of a deterministic automaton;
+/// - BitParallel: BitParallelMatcher for a small non deterministic automaton;
+/// - Nfa: nfa_match().
+/// All have the semantics of matches(), the automaton is factorize()d first.
+class Regex
+{
+public:
+  enum class Engine { Literal, LiteralSet, Dfa, BitParallel, Nfa };
+
+  /// max size of the tables of a BitParallelMatcher
+  static constexpr std::size_t max_bit_parallel_size = 64 * 1024;
+
+  /// \throw std::runtime_error from scan()
+  explicit Regex(char const * pattern, ScanOptions const & options = {});
+  explicit Regex(Ranges rngs);
+
+  bool operator()(char const * s) const;
+
+  /// s[size] is the end of the string, a size out of the bounds of
+  /// analysis() is rejected without reading s
+  bool operator()(char const * s, std::size_t size) const;
+  bool operator()(std::string const & s) const { return (*this)(s.c_str(), s.size()); }
+
+  /// search() with the FirstBytes of the pattern, search_suffix() when
+  /// every final range is an end of line, LiteralSet::search() for a
+  /// LiteralSet without anchor
+  bool search(char const * s) const;
+  bool search(std::string const & s) const { return search(s.c_str()); }
+
+  /// \return  false when no substring is accepted, otherwise
+  ///   [match_first, match_last) is the first substring to end, from its
+  ///   leftmost beginning
+  bool search(char const * s, char const * & match_first, char const * & match_last) const;
+
+  Engine engine() const { return engine_; }
+  Analysis const & analysis() const { return analysis_; }
+  Ranges const & ranges() const { return rngs_; }
+
+private:
+  Ranges rngs_;
+  Analysis analysis_;
+  Engine engine_;
+  BitParallelMatcher bit_parallel_;
+  LiteralSet literal_set_;
+  FirstBytes first_bytes_;
+  /// reverse() of rngs_
+  Ranges reversed_;
+  bool is_suffix_search_;
+  bool is_literal_search_;
+};
+
+char const * to_string(Regex::Engine engine);
+
+} }
+
+#endif
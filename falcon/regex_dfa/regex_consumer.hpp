@@ -94,6 +94,23 @@ namespace falcon { namespace regex_dfa {
         const unsigned char * s;
     };
 
+
+    /// same decoding as utf8_consumer::bumpc(), usable in constant expressions
+    constexpr char_int utf8_bumpc(const char * & s)
+    {
+        char_int c = static_cast<unsigned char>(*s);
+        if (!c) {
+            return c;
+        }
+        ++s;
+        for (int n = 0; n < 3 && static_cast<unsigned char>(*s) >> 6 == 2; ++n) {
+            c <<= 8;
+            c |= static_cast<unsigned char>(*s);
+            ++s;
+        }
+        return c;
+    }
+
 } }
 
 #endif
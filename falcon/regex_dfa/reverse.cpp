@@ -0,0 +1,60 @@
+#include "reverse.hpp"
+#include "redfa.hpp"
+#include "factorize.hpp"
+
+
+namespace falcon { namespace regex_dfa {
+
+Ranges reverse(const Ranges& rngs)
+{
+  Ranges reversed;
+  if (rngs.empty()) {
+    return reversed;
+  }
+
+  // 0: the new first range
+  // i+1: rngs[i], rngs[0] is final
+  // n+1: rngs[0] reached by a Bol transition, only final at the end
+  auto const n = rngs.size();
+  reversed.resize(n + 2);
+  for (auto & rng : reversed) {
+    rng.states = Range::Normal;
+  }
+  // the Range::Bol of the first range anchors its empty substring
+  if (rngs[0].states & (Range::Final | Range::Eol)) {
+    reversed[0].states = rngs[0].states & (Range::Final | Range::Eol | Range::Bol);
+  }
+  reversed[1].states = Range::Final;
+  reversed[n + 1].states = Range::Eol;
+
+  for (std::size_t i = 0; i < n; ++i) {
+    for (auto & t : rngs[i].transitions) {
+      std::size_t next;
+      if (t.states & Transition::Normal) {
+        next = i + 1;
+      }
+      else if (i == 0 && (t.states & Transition::Bol)) {
+        next = n + 1;
+      }
+      // a Bol transition after the first range is never taken
+      else {
+        continue;
+      }
+
+      reversed[t.next + 1].transitions.push_back({t.e, next, Transition::Normal});
+
+      auto const states = rngs[t.next].states;
+      if (states & Range::Final) {
+        reversed[0].transitions.push_back({t.e, next, Transition::Normal});
+      }
+      else if (states & Range::Eol) {
+        reversed[0].transitions.push_back({t.e, next, Transition::Bol});
+      }
+    }
+  }
+
+  factorize(reversed);
+  return reversed;
+}
+
+} }
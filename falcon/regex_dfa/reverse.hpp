@@ -0,0 +1,22 @@
+#ifndef FALCON_REGEX_DFA_REVERSE_HPP
+#define FALCON_REGEX_DFA_REVERSE_HPP
+
+namespace falcon { namespace regex_dfa {
+
+class Ranges;
+
+/// Automaton of the reversed strings of rngs: matches(reverse(rngs), s)
+/// is matches(rngs, s read backward).
+///
+/// The transitions are flipped, the ranges before a final range become
+/// the transitions of the new first range and the first range of rngs
+/// becomes the final one. The anchors are swapped: a transition from an
+/// end of line range requires the beginning of line and a Bol transition
+/// leads to an end of line range. The Range::Bol of an accepting first
+/// range is kept for search_suffix().
+/// The captures are dropped, the result is factorize()d.
+Ranges reverse(Ranges const & rngs);
+
+} }
+
+#endif
@@ -1,10 +1,16 @@
 #include "scan.hpp"
 #include "scan_intervals.hpp"
+#include "case_fold.hpp"
+#include "deterministic.hpp"
+#include "skip_states.hpp"
+#include "decided_states.hpp"
+#include "flat_ranges.hpp"
 #include "range_iterator.hpp"
 #include "trace.hpp"
 
 #include <stdexcept>
 #include <algorithm>
+#include <iterator>
 #include <iostream>
 
 #include <cassert>
@@ -44,6 +50,16 @@ public:
     return capstates;
   }
 
+  /// keep the capacity of the containers
+  void clear() {
+    nb_cap = 0;
+    cap_flags = 0;
+    pcapture = stack_capture;
+    capstates.clear();
+    capspipe.clear();
+    capture_table.clear();
+  }
+
   bool is_full(std::size_t level) const {
     return level == max_cap_level;
   }
@@ -154,25 +170,45 @@ struct basic_scanner
   std::vector<Range> new_rng;
   decltype(irngs) cp_irngs;
   decltype(cp_irngs) tmp_irng;
+  std::vector<unsigned> extended_irng;
+  /// ranges of the previous scans, kept for the capacity of their containers
+  std::vector<Range> spare_rngs;
   /// @}
 
   utf8_consumer consumer {nullptr};
   char_int c;
+  ScanOptions options;
 
+  /// The containers are cleared without release of their memory,
+  /// a scanner can be prepared again after final() or an exception.
   void prepare() {
+    stack.clear();
+    pipe_stack.clear();
+    cap_stack.clear();
+    spare_rngs.insert(
+      spare_rngs.end(),
+      std::make_move_iterator(rngs.begin()),
+      std::make_move_iterator(rngs.end()));
+    rngs.clear();
+    rngs.capture_table.clear();
+    rngs.is_deterministic = false;
+    irngs.clear();
+    iends.clear();
+    ts.clear();
     stack.reserve(8);
     rngs.reserve(8);
     irngs.reserve(8);
     stack.push_back({{}, {}, Range::Normal, Transition::Normal, 0, 0});
-    rngs.push_back({Range::Normal, {}, {}});
+    push_range(Range::Normal, {});
     irngs.push_back(0);
     ipipe = 0;
     states = Range::Normal;
     tr_states = Transition::Normal;
   }
 
-  void scan(const char * s)
+  void scan(const char * s, ScanOptions const & opts)
   {
+    options = opts;
     consumer = utf8_consumer{s};
     c = consumer.bumpc();
 
@@ -206,6 +242,13 @@ struct basic_scanner
   }
 
   Ranges final()
+  {
+    finish();
+    return std::move(rngs);
+  }
+
+  /// final() without move of rngs
+  void finish()
   {
     if (stack.size() > 1) {
       throw std::runtime_error("unmatched )");
@@ -243,8 +286,10 @@ struct basic_scanner
       }
     }
 
-    rngs.capture_table = std::move(cap_stack.capture_table);
-    return std::move(rngs);
+    rngs.capture_table.swap(cap_stack.capture_table);
+    rngs.is_deterministic = is_deterministic(rngs);
+    mark_skip_states(rngs);
+    mark_decided_states(rngs);
   }
 
   /// \return  true if count_rngs()-1 in ipipes, otherwhise false
@@ -290,7 +335,8 @@ struct basic_scanner
       }
 
       auto i = cur_ipipe;
-      auto ie = i + first->irngs_size;
+      // transitions of the alternative to its end (old), reused as pipe
+      auto ie = old;
       assert(ie <= rngs.size());
       for (; i != ie; ++i) {
         for (Transition & t : rngs[i].transitions) {
@@ -331,9 +377,28 @@ struct basic_scanner
     return stack.size() - 1u;
   }
 
+  /// rngs.push_back() with the containers of a spare range when there is one
+  Range & push_range(
+    Range::State rng_states, Captures const & rng_capstates, Transitions const & rng_transitions = {}
+  ) {
+    if (spare_rngs.empty()) {
+      rngs.push_back({rng_states, rng_capstates, rng_transitions});
+      return rngs.back();
+    }
+    rngs.push_back(std::move(spare_rngs.back()));
+    spare_rngs.pop_back();
+    Range & rng = rngs.back();
+    rng.states = rng_states;
+    rng.capstates = rng_capstates;
+    rng.transitions = rng_transitions;
+    rng.hints = Range::NoHint;
+    std::fill(std::begin(rng.escapes), std::end(rng.escapes), '\0');
+    return rng;
+  }
+
   template<class Bool>
   Range & new_range(Bool remove_open_cap) {
-    rngs.push_back({states, cap_stack.captures(), {}});
+    push_range(states, cap_stack.captures());
     if (remove_open_cap) {
       cap_stack.remove_open();
     }
@@ -399,7 +464,7 @@ struct basic_scanner
       };
     };
 
-    std::vector<unsigned> extended_irng;
+    extended_irng.clear();
     if (skip_ipipe) {
       for (auto & t : rngs[0].transitions) {
         if (std::binary_search(irngs.begin(), irngs.end(), t.next)) {
@@ -423,7 +488,9 @@ struct basic_scanner
 
     auto update_rngs = [&] {
       update_transition_indexes();
-      rngs.insert(rngs.end(), new_rng.begin() + 1, new_rng.end());
+      for (auto it = new_rng.begin() + 1; it != new_rng.end(); ++it) {
+        push_range(it->states, it->capstates, it->transitions);
+      }
       insert_transitions(new_rng[0].transitions);
       for (auto && i : range_t{irngs.begin() + skip_ipipe, irngs.end()}) {
         i += count_rng_added;
@@ -473,7 +540,7 @@ struct basic_scanner
 
   void scan_bracket() {
     ts.clear();
-    scan_intervals(consumer, ts, count_rngs(), tr_states);
+    scan_intervals(consumer, ts, count_rngs(), tr_states, options.ignore_case);
     tr_states = Transition::Normal;
     c = consumer.bumpc();
   }
@@ -487,7 +554,7 @@ struct basic_scanner
       Range & rng_base = rngs[stack.back().ipipe];
       states = rng_base.states;
       // TODO cap_stack
-      rngs.push_back({{}, {}, {}});
+      push_range(Range::None, {});
       ipipe = count_rngs()-1;
     }
     if (is_empty && !iends.empty() && iends.back() == irngs.front()) {
@@ -794,6 +861,9 @@ struct basic_scanner
     ts.clear();
     auto const n = count_rngs();
     ts.push_back({e, n, tr_states});
+    if (options.ignore_case && e.is_char()) {
+      fold_case(ts, n, tr_states);
+    }
     tr_states = Transition::Normal;
     c = consumer.bumpc();
   }
@@ -920,14 +990,49 @@ struct basic_scanner
 
 }
 
-Ranges scan(const char * s)
+Ranges scan(const char * s, ScanOptions const & options)
 {
   FALCON_REGEX_DFA_TRACE_FUNC();
   basic_scanner scanner;
   scanner.prepare();
-  scanner.scan(s);
+  scanner.scan(s, options);
   return scanner.final();
 }
 
+
+struct Compiler::Impl
+{
+  basic_scanner scanner;
+};
+
+Compiler::Compiler()
+: impl_(new Impl)
+{}
+
+Compiler::Compiler(Compiler&&) noexcept = default;
+Compiler& Compiler::operator=(Compiler&&) noexcept = default;
+Compiler::~Compiler() = default;
+
+Ranges Compiler::scan(const char* s, ScanOptions const & options)
+{
+  FALCON_REGEX_DFA_TRACE_FUNC();
+  auto & scanner = impl_->scanner;
+  scanner.prepare();
+  scanner.scan(s, options);
+  scanner.finish();
+  // copy, the scanner keeps its containers for the next compilation
+  return scanner.rngs;
+}
+
+FlatRanges Compiler::scan(const char* s, FlatArena& arena, ScanOptions const & options)
+{
+  FALCON_REGEX_DFA_TRACE_FUNC();
+  auto & scanner = impl_->scanner;
+  scanner.prepare();
+  scanner.scan(s, options);
+  scanner.finish();
+  return serialize(scanner.rngs, arena);
+}
+
 }
 }
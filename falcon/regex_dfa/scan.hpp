@@ -3,8 +3,50 @@
 
 #include "redfa.hpp"
 
+#include <memory>
+
 namespace falcon { namespace regex_dfa {
-  Ranges scan(const char * s);
+  struct ScanOptions
+  {
+    /// characters match the ones with the same Unicode simple case folding
+    bool ignore_case = false;
+  };
+
+  /// options as bits, part of the key of a cache of scan()
+  inline unsigned options_bits(ScanOptions const & options)
+  {
+    return options.ignore_case ? 1u : 0u;
+  }
+
+  Ranges scan(const char * s, ScanOptions const & options = {});
+
+  class FlatRanges;
+  class FlatArena;
+
+  /// scan() with a working memory kept between compilations.
+  /// An instance isn't thread safe, use one per thread.
+  class Compiler
+  {
+  public:
+    Compiler();
+    Compiler(Compiler &&) noexcept;
+    Compiler & operator = (Compiler &&) noexcept;
+    ~Compiler();
+
+    /// The returned Ranges are a copy, the scanner keeps its ranges and
+    /// their transitions for the next compilation.
+    /// \throw std::runtime_error
+    Ranges scan(const char * s, ScanOptions const & options = {});
+
+    /// The Ranges of the scanner are serialize()d in arena, without copy
+    /// of these Ranges and without validation of the image.
+    /// \throw std::runtime_error
+    FlatRanges scan(const char * s, FlatArena & arena, ScanOptions const & options = {});
+
+  private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+  };
 } }
 
 #endif // PARSER_HPP
@@ -1,12 +1,14 @@
 #include "scan_intervals.hpp"
 #include "reverse_transitions.hpp"
+#include "case_fold.hpp"
 #include "redfa.hpp"
 
 #include <stdexcept>
 #include <algorithm>
 
 void falcon::regex_dfa::scan_intervals(
-  utf8_consumer& consumer, Transitions& ts, unsigned int next_ts, Transition::State state
+  utf8_consumer& consumer, Transitions& ts, unsigned int next_ts, Transition::State state,
+  bool ignore_case
 ) {
   char_int c = consumer.bumpc();
   bool const reverse = [&]() -> bool {
@@ -70,6 +72,11 @@ void falcon::regex_dfa::scan_intervals(
     throw std::runtime_error("error end of range");
   }
 
+  // [^a] excludes A
+  if (ignore_case) {
+    fold_case(ts, next_ts, state);
+  }
+
   if (reverse) {
     reverse_transitions(ts, next_ts, state);
   }
@@ -9,7 +9,8 @@ namespace falcon { namespace regex_dfa {
     utf8_consumer & consumer,
     Transitions & ts,
     unsigned next_ts,
-    Transition::State state
+    Transition::State state,
+    bool ignore_case = false
   );
 } }
 
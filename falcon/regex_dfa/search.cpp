@@ -0,0 +1,352 @@
+#include "search.hpp"
+#include "redfa.hpp"
+#include "regex_consumer.hpp"
+
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+
+// the aligned loads of find() read after the nul, in the same page
+#if defined(__SSE2__) && !defined(__SANITIZE_ADDRESS__)
+# define FALCON_REGEX_DFA_HAS_SSE2_FIND 1
+# include <emmintrin.h>
+#else
+# define FALCON_REGEX_DFA_HAS_SSE2_FIND 0
+#endif
+
+
+namespace falcon { namespace regex_dfa {
+
+namespace {
+
+unsigned nb_bytes(char_int c)
+{
+  return c >> 24 ? 4 : c >> 16 ? 3 : c >> 8 ? 2 : 1;
+}
+
+unsigned first_byte(char_int c)
+{
+  return c >> (8 * (nb_bytes(c) - 1)) & 0xff;
+}
+
+}
+
+FirstBytes::FirstBytes()
+{
+  bits_.set();
+  update_bytes();
+}
+
+FirstBytes::FirstBytes(const Ranges& rngs)
+{
+  if (rngs.empty()) {
+    bits_.set();
+  }
+  else {
+    auto insert = [this](unsigned l, unsigned r) {
+      for (; l <= r; ++l) {
+        bits_.set(l);
+      }
+    };
+    for (auto & t : rngs[0].transitions) {
+      if (!(t.states & Transition::Normal)) {
+        continue;
+      }
+      // packed characters are ordered by size
+      if (nb_bytes(t.e.l) == nb_bytes(t.e.r)) {
+        insert(first_byte(t.e.l), first_byte(t.e.r));
+      }
+      else {
+        insert(first_byte(t.e.l), 0xff);
+        insert(0xc0, first_byte(t.e.r));
+      }
+    }
+  }
+  update_bytes();
+}
+
+void FirstBytes::update_bytes()
+{
+  bits_.reset(0);
+  for (unsigned c = 0x80; c < 0xc0; ++c) {
+    bits_.reset(c);
+  }
+
+  has_bytes_ = size() < sizeof(bytes_);
+  if (has_bytes_) {
+    char * p = bytes_;
+    for (unsigned c = 1; c < 256; ++c) {
+      if (bits_[c]) {
+        *p++ = char(c);
+      }
+    }
+    *p = 0;
+  }
+
+  for (unsigned c = 0; c < 256; ++c) {
+    stops_[c] = bits_[c];
+  }
+  stops_[0] = 1;
+
+  // intervals of bytes of the set
+  nb_intervals_ = 0;
+  for (unsigned c = 1; c < 256; ++c) {
+    if (!bits_[c]) {
+      continue;
+    }
+    if (nb_intervals_ == max_intervals) {
+      nb_intervals_ = max_intervals + 1;
+      break;
+    }
+    unsigned r = c;
+    while (r + 1 < 256 && bits_[r + 1]) {
+      ++r;
+    }
+    lows_[nb_intervals_] = static_cast<unsigned char>(c);
+    widths_[nb_intervals_] = static_cast<unsigned char>(r - c);
+    ++nb_intervals_;
+    c = r;
+  }
+}
+
+const char* FirstBytes::find(const char* s) const
+{
+#if FALCON_REGEX_DFA_HAS_SSE2_FIND
+  // x is in [l, l + w] when the saturated (x - l) - w is 0
+  if (nb_intervals_ <= max_intervals) {
+    __m128i lows[max_intervals];
+    __m128i widths[max_intervals];
+    for (unsigned i = 0; i < nb_intervals_; ++i) {
+      lows[i] = _mm_set1_epi8(static_cast<char>(lows_[i]));
+      widths[i] = _mm_set1_epi8(static_cast<char>(widths_[i]));
+    }
+    __m128i const zero = _mm_setzero_si128();
+
+    // a load aligned on 16 bytes doesn't cross a page,
+    // the bytes before s are masked in the first block
+    auto const offset = reinterpret_cast<uintptr_t>(s) & 15u;
+    auto p = s - offset;
+    unsigned ignored = (1u << offset) - 1u;
+    for (;; p += 16, ignored = 0) {
+      __m128i const x = _mm_load_si128(reinterpret_cast<__m128i const *>(p));
+      __m128i found = _mm_cmpeq_epi8(x, zero);
+      for (unsigned i = 0; i < nb_intervals_; ++i) {
+        __m128i const d = _mm_subs_epu8(_mm_sub_epi8(x, lows[i]), widths[i]);
+        found = _mm_or_si128(found, _mm_cmpeq_epi8(d, zero));
+      }
+      auto const mask = static_cast<unsigned>(_mm_movemask_epi8(found)) & ~ignored;
+      if (mask) {
+        return p + __builtin_ctz(mask);
+      }
+    }
+  }
+#endif
+
+  // strcspn() is vectorized by the libc
+  if (has_bytes_) {
+    return s + std::strcspn(s, bytes_);
+  }
+  // the nul stops before the next byte is read
+  auto stops = [this](char c) { return stops_[static_cast<unsigned char>(c)]; };
+  for (;; s += 4) {
+    if (stops(s[0])) { return s; }
+    if (stops(s[1])) { return s + 1; }
+    if (stops(s[2])) { return s + 2; }
+    if (stops(s[3])) { return s + 3; }
+  }
+}
+
+
+namespace {
+
+/// empty substring of the first range at the end of s.
+/// With a Range::Bol it is only accepted when the end is the beginning.
+bool is_empty_end_accepted(const Range& rng, bool is_beginning)
+{
+  return (rng.states & Range::Eol) && (is_beginning || !(rng.states & Range::Bol));
+}
+
+/// Simulation of rngs where the first range is added at each character.
+/// \return  end of the first accepted substring, nullptr when none
+const char* find_last(const Ranges& rngs, const FirstBytes& first, const char* s)
+{
+  auto has_state = [&rngs](std::size_t i, Range::State e) {
+    return bool(rngs[i].states & e);
+  };
+
+  // empty substring at the beginning
+  if (has_state(0, Range::Final)) {
+    return s;
+  }
+
+  // ranges of the substrings in progress, the first range is added
+  // at each character for the substrings that begin there
+  std::vector<std::size_t> t1;
+  std::vector<std::size_t> t2;
+  std::vector<std::size_t> steps(rngs.size(), 0);
+  std::size_t step = 0;
+
+  utf8_consumer consumer(s);
+  auto states = Transition::Normal | Transition::Bol;
+  char_int c;
+
+  auto next = [&](std::size_t i, Transition::State states) {
+    for (auto && t : rngs[i].transitions) {
+      if (bool(t.states & states) && t.e.contains(c) && steps[t.next] != step) {
+        steps[t.next] = step;
+        t2.push_back(t.next);
+      }
+    }
+  };
+
+  for (;;) {
+    if (t1.empty() && states == Transition::Normal) {
+      consumer.str(first.find(consumer.str()));
+    }
+    if (!(c = consumer.bumpc())) {
+      break;
+    }
+
+    ++step;
+    next(0, states);
+    for (std::size_t i : t1) {
+      next(i, Transition::Normal);
+    }
+    if (std::any_of(t2.begin(), t2.end(), [&](std::size_t i) { return has_state(i, Range::Final); })) {
+      return consumer.str();
+    }
+
+    using std::swap;
+    swap(t1, t2);
+    t2.clear();
+    states = Transition::Normal;
+  }
+
+  // empty substring at the end
+  if (is_empty_end_accepted(rngs[0], consumer.str() == s)
+   || std::any_of(t1.begin(), t1.end(), [&](std::size_t i) { return has_state(i, Range::Eol); })
+  ) {
+    return consumer.str();
+  }
+  return nullptr;
+}
+
+/// Simulation of reversed from last to s, read backward.
+/// \return  beginning of the accepted substring that ends at last, the
+///   leftmost when is_leftmost is true, otherwise the first found.
+///   nullptr when none
+const char* find_first(
+  const Ranges& reversed, const char* s, const char* last, bool is_leftmost
+) {
+  auto has_state = [&reversed](std::size_t i, Range::State e) {
+    return bool(reversed[i].states & e);
+  };
+  auto is_accepted = [&](std::size_t i, const char* p) {
+    return has_state(i, Range::Final) || (p == s && has_state(i, Range::Eol));
+  };
+
+  // the empty substring of the first range is at last,
+  // with a Range::Bol only when last is also the beginning
+  const char* found = has_state(0, Range::Final)
+    || (!*last && has_state(0, Range::Eol) && (last == s || !has_state(0, Range::Bol)))
+    ? last : nullptr;
+  if (found && !is_leftmost) {
+    return found;
+  }
+
+  std::vector<std::size_t> t1 {0};
+  std::vector<std::size_t> t2;
+  std::vector<std::size_t> steps(reversed.size(), 0);
+  std::size_t step = 0;
+
+  // Bol transitions of the reversed automaton are the end of s
+  auto states = *last ? Transition::Normal : Transition::Normal | Transition::Bol;
+  const char* p = last;
+
+  while (p != s && !t1.empty()) {
+    // same character as utf8_consumer::bumpc() on valid UTF-8
+    const char* q = p - 1;
+    for (int n = 0; n < 3 && q != s && (static_cast<unsigned char>(*q) & 0xc0) == 0x80; ++n) {
+      --q;
+    }
+    char_int c = 0;
+    for (const char* it = q; it != p; ++it) {
+      c = (c << 8) | static_cast<unsigned char>(*it);
+    }
+    p = q;
+
+    ++step;
+    for (std::size_t i : t1) {
+      for (auto && t : reversed[i].transitions) {
+        if (bool(t.states & states) && t.e.contains(c) && steps[t.next] != step) {
+          steps[t.next] = step;
+          t2.push_back(t.next);
+        }
+      }
+    }
+    if (std::any_of(t2.begin(), t2.end(), [&](std::size_t i) { return is_accepted(i, p); })) {
+      found = p;
+      if (!is_leftmost) {
+        return found;
+      }
+    }
+
+    using std::swap;
+    swap(t1, t2);
+    t2.clear();
+    states = Transition::Normal;
+  }
+
+  return found;
+}
+
+}
+
+bool search(const Ranges& rngs, const char* s)
+{
+  return search(rngs, FirstBytes(rngs), s);
+}
+
+bool search(const Ranges& rngs, const FirstBytes& first, const char* s)
+{
+  // empty substring at the beginning or at the end
+  if (rngs.empty()
+   || (rngs[0].states & Range::Final)
+   || is_empty_end_accepted(rngs[0], !*s)
+  ) {
+    return true;
+  }
+  return find_last(rngs, first, s);
+}
+
+bool search(
+  const Ranges& rngs, const FirstBytes& first, const Ranges& reversed,
+  const char* s, const char*& match_first, const char*& match_last
+) {
+  if (rngs.empty()) {
+    match_first = match_last = s;
+    return true;
+  }
+
+  auto const last = find_last(rngs, first, s);
+  if (!last) {
+    return false;
+  }
+  auto const first_found = find_first(reversed, s, last, true);
+  if (!first_found) {
+    return false;
+  }
+  match_first = first_found;
+  match_last = last;
+  return true;
+}
+
+bool search_suffix(const Ranges& reversed, const char* s)
+{
+  if (reversed.empty()) {
+    return true;
+  }
+  return find_first(reversed, s, s + std::strlen(s), false);
+}
+
+} }
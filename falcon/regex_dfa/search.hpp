@@ -0,0 +1,76 @@
+#ifndef FALCON_REGEX_DFA_SEARCH_HPP
+#define FALCON_REGEX_DFA_SEARCH_HPP
+
+#include <bitset>
+#include <cstddef>
+
+
+namespace falcon { namespace regex_dfa {
+
+class Ranges;
+
+/// Set of the bytes that can begin a match after the beginning of a
+/// string: the first bytes of the Normal transitions of the first range.
+/// The continuation bytes of UTF-8 are never in the set.
+class FirstBytes
+{
+public:
+  /// every byte
+  FirstBytes();
+
+  explicit FirstBytes(Ranges const & rngs);
+
+  bool contains(unsigned char c) const { return bits_[c]; }
+  std::size_t size() const { return bits_.count(); }
+
+  /// \return  first position of s with a byte of the set or the terminating nul.
+  /// With SSE2, a set of at most max_intervals intervals of bytes is
+  /// compared to 16 bytes at once. Otherwise strcspn() of the libc is used
+  /// for at most 16 bytes and a table lookup unrolled by 4 for more.
+  char const * find(char const * s) const;
+
+  /// max number of intervals of bytes of the SSE2 find()
+  static constexpr unsigned max_intervals = 4;
+
+private:
+  void update_bytes();
+
+  std::bitset<256> bits_;
+  /// bytes of the set for strcspn() when they are at most 16, nul terminated
+  char bytes_[17] {};
+  bool has_bytes_ = false;
+  /// 1 for the bytes of the set and the nul, used by find() without bytes_
+  unsigned char stops_[256] {};
+  /// intervals [lows_[i], lows_[i] + widths_[i]] of the set,
+  /// nb_intervals_ is max_intervals + 1 when there are more
+  unsigned char lows_[max_intervals] {};
+  unsigned char widths_[max_intervals] {};
+  unsigned nb_intervals_ = 0;
+};
+
+/// \return  true when a substring of s is accepted by matches().
+/// A Bol transition only matches at the beginning of s and
+/// a Range::Eol only at the end.
+bool search(Ranges const & rngs, char const * s);
+/// \pre  first is FirstBytes(rngs)
+bool search(Ranges const & rngs, FirstBytes const & first, char const * s);
+
+/// Same as search(), [match_first, match_last) is the first substring
+/// to end, from its leftmost beginning. The end is found by a pass on s,
+/// the beginning by a pass of reversed backward from the end.
+/// \pre  first is FirstBytes(rngs) and reversed is reverse(rngs)
+bool search(
+  Ranges const & rngs, FirstBytes const & first, Ranges const & reversed,
+  char const * s, char const * & match_first, char const * & match_last);
+
+/// \return  true when a suffix of s is accepted by matches(rngs),
+/// a Bol transition or the empty substring of a first range with
+/// Range::Bol only at the beginning of s. reversed runs backward from the end of s and stops at the first
+/// suffix accepted or when no substring is in progress, this is
+/// search() for the patterns anchored at the end.
+/// \pre  reversed is reverse(rngs)
+bool search_suffix(Ranges const & reversed, char const * s);
+
+} }
+
+#endif
@@ -0,0 +1,90 @@
+#include "skip_states.hpp"
+#include "redfa.hpp"
+
+#include <algorithm>
+
+
+namespace falcon { namespace regex_dfa {
+
+namespace {
+
+constexpr std::size_t max_escapes = sizeof(Range::escapes) - 1;
+
+struct Escapes
+{
+  char_int chars[max_escapes];
+  std::size_t size = 0;
+
+  /// \return  false when e has too many characters or not ascii characters
+  bool add(Event e) {
+    if (!e.l || e.r >= 0x80 || e.r - e.l >= max_escapes) {
+      return false;
+    }
+    for (char_int c = e.l; c <= e.r; ++c) {
+      if (std::find(chars, chars + size, c) == chars + size) {
+        if (size == max_escapes) {
+          return false;
+        }
+        chars[size++] = c;
+      }
+    }
+    return true;
+  }
+};
+
+bool compute_escapes(Range const & rng, std::size_t irng, Escapes & escapes)
+{
+  std::vector<Event> loops;
+
+  for (auto & t : rng.transitions) {
+    if (!(t.states & Transition::Normal)) {
+      continue;
+    }
+    if (t.next == irng) {
+      loops.push_back(t.e);
+    }
+    else if (!escapes.add(t.e)) {
+      return false;
+    }
+  }
+
+  if (loops.empty()) {
+    return false;
+  }
+
+  std::sort(loops.begin(), loops.end());
+
+  // characters without loop are escapes
+  char_int c = 1;
+  for (Event const & e : loops) {
+    if (e.l > c && !escapes.add({c, e.l - 1})) {
+      return false;
+    }
+    if (e.r == ~char_int{}) {
+      return true;
+    }
+    c = std::max(c, e.r + 1);
+  }
+
+  return false;
+}
+
+}
+
+void mark_skip_states(Ranges& rngs)
+{
+  std::size_t irng = 0;
+  for (Range & rng : rngs) {
+    Escapes escapes;
+    if (compute_escapes(rng, irng, escapes)) {
+      rng.hints |= Range::Skip;
+      std::transform(escapes.chars, escapes.chars + escapes.size, rng.escapes, [](char_int c) {
+        return char(c);
+      });
+      rng.escapes[escapes.size] = 0;
+    }
+    ++irng;
+  }
+}
+
+} }
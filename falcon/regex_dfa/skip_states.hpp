@@ -0,0 +1,16 @@
+#ifndef FALCON_REGEX_DFA_SKIP_STATES_HPP
+#define FALCON_REGEX_DFA_SKIP_STATES_HPP
+
+namespace falcon { namespace regex_dfa {
+
+class Ranges;
+
+/// Set Range::Skip on the ranges where any character loops on the range
+/// except at most 3 ascii characters (Range::escapes).
+/// Since an ascii byte never appears in a multibyte utf8 sequence,
+/// the matchers jump to the next escape with strcspn.
+void mark_skip_states(Ranges & rngs);
+
+} }
+
+#endif
@@ -0,0 +1,89 @@
+#include "static_regex.hpp"
+#include "scan.hpp"
+
+#include <algorithm>
+#include <ostream>
+#include <ios>
+
+
+namespace falcon { namespace regex_dfa {
+
+namespace {
+
+void write_string(std::ostream & out, char const * s)
+{
+  out << '"';
+  for (; *s; ++s) {
+    switch (*s) {
+      case '"': out << "\\\""; break;
+      case '\\': out << "\\\\"; break;
+      case '\n': out << "\\n"; break;
+      default: out << *s;
+    }
+  }
+  out << '"';
+}
+
+}
+
+void write_static_regex(std::ostream& out, const char* name, const Ranges& rngs)
+{
+  std::size_t nb_transitions = 0;
+  for (auto & rng : rngs) {
+    nb_transitions += rng.transitions.size();
+  }
+
+  out
+    << "constexpr falcon::regex_dfa::static_regex<"
+    << rngs.size() << ", " << std::max(nb_transitions, std::size_t{1})
+    << "> " << name << " {\n  {\n"
+  ;
+
+  std::size_t first_transition = 0;
+  for (auto & rng : rngs) {
+    out
+      << "    {" << uint32_t(rng.states)
+      << ", " << first_transition
+      << ", " << rng.transitions.size()
+      << ", " << uint32_t(rng.hints & (Range::AcceptAll | Range::Dead))
+      << "},\n"
+    ;
+    first_transition += rng.transitions.size();
+  }
+
+  out << "  },\n  {\n";
+  if (!nb_transitions) {
+    out << "    {},\n";
+  }
+  for (auto & rng : rngs) {
+    for (auto & t : rng.transitions) {
+      out
+        << "    {{" << t.e.l << "u, " << t.e.r
+        << "u}, " << t.next
+        << ", " << uint32_t(t.states)
+        << "},\n"
+      ;
+    }
+  }
+  out << "  },\n  " << std::boolalpha << rngs.is_deterministic << "\n};\n";
+}
+
+void write_static_regex(
+  std::ostream& out,
+  const char* const* names,
+  const char* const* patterns,
+  std::size_t n
+) {
+  out <<
+    "// generated by re_scan --cpp\n"
+    "#include \"falcon/regex_dfa/static_regex.hpp\"\n"
+  ;
+  for (std::size_t i = 0; i < n; ++i) {
+    out << "\n// pattern: ";
+    write_string(out, patterns[i]);
+    out << "\n";
+    write_static_regex(out, names[i], scan(patterns[i]));
+  }
+}
+
+} }
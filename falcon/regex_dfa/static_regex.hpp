@@ -0,0 +1,141 @@
+#ifndef FALCON_REGEX_DFA_STATIC_REGEX_HPP
+#define FALCON_REGEX_DFA_STATIC_REGEX_HPP
+
+#include "flat_ranges.hpp"
+
+#include <iosfwd>
+
+
+namespace falcon { namespace regex_dfa {
+
+struct StaticRange
+{
+  uint32_t states;
+  uint32_t first_transition;
+  uint32_t nb_transitions;
+  /// Range::AcceptAll and Range::Dead
+  uint32_t hints;
+};
+
+/// Constant tables of a Ranges with a constexpr matcher.
+/// Instances are generated by write_static_regex() (re_scan --cpp)
+/// and have the semantics of matches().
+template<std::size_t NbRanges, std::size_t NbTransitions>
+struct static_regex
+{
+  StaticRange ranges[NbRanges];
+  flat::Transition transitions[NbTransitions];
+  bool is_deterministic;
+
+  constexpr bool operator()(char const * s) const
+  {
+    return is_deterministic ? match(s) : nfa_match(s);
+  }
+
+  constexpr bool match(char const * s) const
+  {
+    uint32_t i = 0;
+    char_int c = 0;
+    if (!is_decided(0) && (c = utf8_bumpc(s)) && next(i, c, Transition::Normal | Transition::Bol)) {
+      while (!is_decided(i) && (c = utf8_bumpc(s)) && next(i, c, Transition::Normal)) {
+      }
+    }
+    if (ranges[i].hints & uint32_t(Range::AcceptAll)) {
+      return true;
+    }
+    return !c && is_final(i);
+  }
+
+  constexpr bool nfa_match(char const * s) const
+  {
+    if (is_decided(0)) {
+      return ranges[0].hints & uint32_t(Range::AcceptAll);
+    }
+
+    bool t1[NbRanges] {};
+    bool t2[NbRanges] {};
+    t1[0] = true;
+
+    auto states = Transition::Normal | Transition::Bol;
+    char_int c = 0;
+    bool has_state = true;
+    while (has_state && (c = utf8_bumpc(s))) {
+      has_state = false;
+      for (std::size_t i = 0; i < NbRanges; ++i) {
+        if (!t1[i]) {
+          continue;
+        }
+        auto const & rng = ranges[i];
+        for (auto it = rng.first_transition; it < rng.first_transition + rng.nb_transitions; ++it) {
+          auto const & t = transitions[it];
+          if ((t.states & states) && t.e.contains(c)) {
+            auto const hints = ranges[t.next].hints;
+            if (hints & uint32_t(Range::AcceptAll)) {
+              return true;
+            }
+            // a Range::Dead never leads to a final range
+            if (!(hints & uint32_t(Range::Dead))) {
+              has_state = t2[t.next] = true;
+            }
+          }
+        }
+      }
+      for (std::size_t i = 0; i < NbRanges; ++i) {
+        t1[i] = t2[i];
+        t2[i] = false;
+      }
+      states = Transition::Normal;
+    }
+
+    if (!has_state) {
+      return false;
+    }
+    for (std::size_t i = 0; i < NbRanges; ++i) {
+      if (t1[i] && is_final(i)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+private:
+  constexpr bool next(uint32_t & i, char_int c, Transition::State states) const
+  {
+    auto const & rng = ranges[i];
+    for (auto it = rng.first_transition; it < rng.first_transition + rng.nb_transitions; ++it) {
+      auto const & t = transitions[it];
+      if ((t.states & states) && t.e.contains(c)) {
+        i = t.next;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// the result is known in a Range::AcceptAll or a Range::Dead
+  constexpr bool is_decided(std::size_t i) const
+  {
+    return ranges[i].hints & (uint32_t(Range::AcceptAll) | uint32_t(Range::Dead));
+  }
+
+  constexpr bool is_final(std::size_t i) const
+  {
+    return ranges[i].states & (uint32_t(Range::Final) | uint32_t(Range::Eol));
+  }
+};
+
+/// Write a header with a constexpr static_regex named name for each pattern.
+/// \throw std::runtime_error
+void write_static_regex(
+  std::ostream & out,
+  char const * const * names,
+  char const * const * patterns,
+  std::size_t n
+);
+
+/// Write the definition of a constexpr static_regex named name.
+void write_static_regex(std::ostream & out, char const * name, Ranges const & rngs);
+
+} }
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef FALCON_REGEX_DFA_STATS_HPP
+#define FALCON_REGEX_DFA_STATS_HPP
+
+#include <cstdint>
+
+#if defined(FALCON_REGEX_DFA_ENABLE_STATS) && FALCON_REGEX_DFA_ENABLE_STATS != 0
+# define FALCON_REGEX_DFA_STATS(...) void(__VA_ARGS__)
+#else
+# define FALCON_REGEX_DFA_STATS(...) void()
+#endif
+
+
+namespace falcon { namespace regex_dfa {
+
+/// Counters of match() and nfa_match(), accumulated by thread.
+struct MatchStats
+{
+  uint64_t calls;
+  /// characters read by the automaton
+  uint64_t characters;
+  /// bytes jumped over in a Range::Skip
+  uint64_t skipped_bytes;
+  uint64_t states_entered;
+  uint64_t transitions_examined;
+  /// maximum number of active states of nfa_match()
+  uint64_t peak_active_states;
+  /// failures before the end of the string
+  uint64_t early_exits;
+  /// successes before the end of the string (Range::AcceptAll)
+  uint64_t early_accepts;
+};
+
+/// Counters of the calling thread.
+/// They are updated only when the library is built with
+/// FALCON_REGEX_DFA_ENABLE_STATS (cmake -DRE_STATS=1).
+MatchStats const & match_stats();
+void reset_match_stats();
+
+/// true when the library is built with FALCON_REGEX_DFA_ENABLE_STATS
+bool has_match_stats();
+
+} }
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef FALCON_REGEX_DFA_TEST_CHECK_HPP
+#define FALCON_REGEX_DFA_TEST_CHECK_HPP
+
+#include <iostream>
+
+/// defined by each test
+extern unsigned count_test_failure;
+
+inline void check(bool ok, char const * expr, unsigned line)
+{
+  if (!ok) {
+    std::cerr << ++count_test_failure << "  line: " << line << "\n " << expr << "\n----------\n";
+  }
+}
+
+#define CHECK(expr) check(expr, #expr, __LINE__)
+
+#endif
@@ -0,0 +1,107 @@
+#include "falcon/regex_dfa/analysis.hpp"
+#include "falcon/regex_dfa/scan.hpp"
+#include "check.hpp"
+
+#include <iostream>
+
+unsigned count_test_failure = 0;
+
+namespace re = falcon::regex_dfa;
+
+constexpr auto inf = re::infinite_length;
+
+void test_length(char const * pattern, bool in_bytes, std::size_t min, std::size_t max, unsigned line)
+{
+  auto const a = re::analyze(re::scan(pattern));
+  auto const amin = in_bytes ? a.min_bytes : a.min_length;
+  auto const amax = in_bytes ? a.max_bytes : a.max_length;
+  if (amin != min || amax != max) {
+    std::cerr
+      << ++count_test_failure << "  line: " << line
+      << "\n pattern: " << pattern
+      << "\n " << (in_bytes ? "bytes" : "length") << ": [" << amin << ", " << amax << "]"
+      << " expected: [" << min << ", " << max << "]\n----------\n";
+  }
+}
+
+#define LENGTH(pattern, min, max) test_length(pattern, false, min, max, __LINE__)
+#define BYTES(pattern, min, max) test_length(pattern, true, min, max, __LINE__)
+
+int main() {
+  {
+    auto const a = re::analyze(re::scan("abc"));
+    CHECK(a.nb_states == 4);
+    CHECK(a.nb_transitions == 3);
+    CHECK(a.is_deterministic);
+    CHECK(a.is_literal);
+    CHECK(a.literal == "abc");
+    CHECK(!a.is_anchored_begin);
+    CHECK(!a.is_anchored_end);
+  }
+  {
+    auto const a = re::analyze(re::scan("^abc$"));
+    CHECK(a.is_literal);
+    CHECK(a.literal == "abc");
+    CHECK(a.is_anchored_begin);
+    CHECK(a.is_anchored_end);
+  }
+  {
+    auto const a = re::analyze(re::scan("é€"));
+    CHECK(a.is_literal);
+    CHECK(a.literal == "é€");
+    CHECK(a.min_length == 2);
+  }
+  CHECK(re::analyze(re::scan("")).is_literal);
+  CHECK(!re::analyze(re::scan("a|b")).is_literal);
+  CHECK(!re::analyze(re::scan("ab?")).is_literal);
+  CHECK(!re::analyze(re::scan("a+")).is_literal);
+  CHECK(!re::analyze(re::scan("[ab]")).is_literal);
+  CHECK(!re::analyze(re::scan("[a-c]*a[a-c]")).is_deterministic);
+
+  {
+    using strings = std::vector<std::string>;
+    CHECK(re::analyze(re::scan("(GET|PUT|POST)")).literals == (strings{"GET", "POST", "PUT"}));
+    CHECK(re::analyze(re::scan("[ab]c?")).literals == (strings{"a", "ac", "b", "bc"}));
+    CHECK(re::analyze(re::scan("abc")).literals == strings{"abc"});
+    CHECK(re::analyze(re::scan("a?")).literals == (strings{"", "a"}));
+    CHECK(re::analyze(re::scan("a+")).literals.empty());
+    CHECK(re::analyze(re::scan("[a-z]")).literals.empty());
+    CHECK(re::analyze(re::scan("[a-d]{5}")).literals.empty());
+    CHECK(re::analyze(re::scan("a^b")).literals.empty());
+  }
+
+  LENGTH("", 0, 0);
+  LENGTH("abc", 3, 3);
+  LENGTH("a?b?", 0, 2);
+  LENGTH("a+", 1, inf);
+  LENGTH("a*", 0, inf);
+  LENGTH("[0-9]{2}-[0-9]+", 4, inf);
+  LENGTH("[0-9]{2,4}", 2, 4);
+  LENGTH("(a|b)*c", 1, inf);
+  LENGTH("^a|^.?", 0, 1);
+  LENGTH("a^b", inf, 0);
+
+  BYTES("", 0, 0);
+  BYTES("abc", 3, 3);
+  BYTES("éa€", 6, 6);
+  LENGTH("éa€", 3, 3);
+  BYTES("[aé]", 1, 2);
+  BYTES("a?é?", 0, 3);
+  BYTES("é+", 2, inf);
+  BYTES(".", 1, 4);
+  BYTES("a^b", inf, 0);
+
+  {
+    auto const a = re::analyze(re::scan("[0-9]{2,4}"));
+    CHECK(!re::is_accepted_size(a, 1));
+    CHECK(re::is_accepted_size(a, 2));
+    CHECK(re::is_accepted_size(a, 4));
+    CHECK(!re::is_accepted_size(a, 5));
+  }
+  CHECK(re::is_accepted_size(re::analyze(re::Ranges{}), 100));
+
+  if (count_test_failure) {
+    std::cerr << "error(s): " << count_test_failure << "\n";
+  }
+  return count_test_failure ? 1 : 0;
+}
@@ -0,0 +1,90 @@
+#include "test_codegen.hpp"
+#include "falcon/regex_dfa/scan.hpp"
+#include "falcon/regex_dfa/match.hpp"
+
+#include <iostream>
+
+unsigned count_test_failure = 0;
+
+namespace re = falcon::regex_dfa;
+
+void test(
+  bool (*f)(char const *)
+, char const * pattern
+, char const * s
+, unsigned line
+) {
+  bool const is_ok = re::matches(re::scan(pattern), s);
+  if (f(s) != is_ok) {
+    std::cerr
+      << ++count_test_failure << "  line: " << line
+      << "\n\n pattern: \033[37;02m" << pattern
+      << "\n\033[0m str: \033[37;02m" << s
+      << "\n\033[0m expected match: " << is_ok
+      << "\n----------\n"
+    ;
+  }
+}
+
+#define TEST(name, pattern, s) test(name, pattern, s, __LINE__)
+
+int main() {
+  TEST(empty, "^$", "");
+  TEST(empty, "^$", "a");
+
+  TEST(email, "[a-z]+@[a-z]+", "a@b");
+  TEST(email, "[a-z]+@[a-z]+", "abc@def");
+  TEST(email, "[a-z]+@[a-z]+", "abc@");
+  TEST(email, "[a-z]+@[a-z]+", "@def");
+  TEST(email, "[a-z]+@[a-z]+", "abc@def@");
+
+  TEST(suffix, ".*a$", "a");
+  TEST(suffix, ".*a$", "éa");
+  TEST(suffix, ".*a$", "aaab");
+  TEST(suffix, ".*a$", "");
+
+  TEST(digits, "[0-9]{2}-[0-9]+", "12-3");
+  TEST(digits, "[0-9]{2}-[0-9]+", "12-345");
+  TEST(digits, "[0-9]{2}-[0-9]+", "12-");
+  TEST(digits, "[0-9]{2}-[0-9]+", "1-34");
+
+  TEST(quoted, "\"[^\"]*\"", "\"\"");
+  TEST(quoted, "\"[^\"]*\"", "\"abé\"");
+  TEST(quoted, "\"[^\"]*\"", "\"ab\"c\"");
+  TEST(quoted, "\"[^\"]*\"", "\"ab");
+
+  TEST(word, "^(?!GET|HEAD|POST|PUT)$", "GET");
+  TEST(word, "^(?!GET|HEAD|POST|PUT)$", "PUT");
+  TEST(word, "^(?!GET|HEAD|POST|PUT)$", "POST");
+  TEST(word, "^(?!GET|HEAD|POST|PUT)$", "PU");
+  TEST(word, "^(?!GET|HEAD|POST|PUT)$", "DELETE");
+
+  TEST(unicode, "[éê]+", "éê");
+  TEST(unicode, "[éê]+", "e");
+
+  TEST(anchored, "^a{1,2}a+", "aa");
+  TEST(anchored, "^a{1,2}a+", "aaaa");
+  TEST(anchored, "^a{1,2}a+", "a");
+  TEST(anchored, "^a{1,2}a+", "ba");
+
+  TEST(anchored_or, "c|($)^a.+", "c");
+  TEST(anchored_or, "c|($)^a.+", "ab");
+  TEST(anchored_or, "c|($)^a.+", "a");
+  TEST(anchored_or, "c|($)^a.+", "cab");
+
+  TEST(any, ".*", "");
+  TEST(any, ".*", "abc");
+
+  TEST(get, "^GET .*", "GET /index.html");
+  TEST(get, "^GET .*", "GET ");
+  TEST(get, "^GET .*", "GET");
+  TEST(get, "^GET .*", "GE /");
+
+  TEST(prefix, "(a|ab).*c?", "abxxxx");
+  TEST(prefix, "(a|ab).*c?", "ba");
+
+  if (count_test_failure) {
+    std::cerr << "error(s): " << count_test_failure << "\n";
+  }
+  return count_test_failure ? 1 : 0;
+}
@@ -0,0 +1,50 @@
+#include "falcon/regex_dfa/compile_all.hpp"
+#include "falcon/regex_dfa/scan.hpp"
+#include "check.hpp"
+
+#include <iostream>
+
+unsigned count_test_failure = 0;
+
+namespace re = falcon::regex_dfa;
+
+int main() {
+  std::vector<std::string> patterns;
+  for (int i = 0; i < 100; ++i) {
+    patterns.push_back(std::to_string(i) + "[a-z]+|(ab)*");
+  }
+  patterns[42] = "a)";
+  patterns[77] = "a{3,2}";
+
+  for (unsigned nb_threads : {0u, 1u, 4u, 64u}) {
+    auto const results = re::compile_all(patterns, nb_threads);
+    CHECK(results.size() == patterns.size());
+    for (std::size_t i = 0; i < results.size(); ++i) {
+      if (i == 42 || i == 77) {
+        CHECK(!results[i].ok());
+        CHECK(results[i].ranges.empty());
+      }
+      else {
+        CHECK(results[i].ok());
+        CHECK(results[i].ranges == re::scan(patterns[i].c_str()));
+      }
+    }
+  }
+
+  char const * patterns2[] = {"a", "b|c"};
+  auto const results = re::compile_all(patterns2, 2);
+  CHECK(results.size() == 2);
+  CHECK(results[1].ranges == re::scan("b|c"));
+  CHECK(re::compile_all(patterns2, 0, 4).empty());
+
+  re::ScanOptions icase;
+  icase.ignore_case = true;
+  auto const results2 = re::compile_all(patterns2, 2, 2, icase);
+  CHECK(results2[1].ranges == re::scan("b|c", icase));
+  CHECK(!(results2[1].ranges == results[1].ranges));
+
+  if (count_test_failure) {
+    std::cerr << "error(s): " << count_test_failure << "\n";
+  }
+  return count_test_failure ? 1 : 0;
+}
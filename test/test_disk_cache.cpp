@@ -0,0 +1,90 @@
+#include "falcon/regex_dfa/disk_cache.hpp"
+#include "falcon/regex_dfa/match.hpp"
+#include "check.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <cstdio>
+
+#include <unistd.h>
+
+unsigned count_test_failure = 0;
+
+namespace re = falcon::regex_dfa;
+
+int main() {
+  char dir[] = "/tmp/test_disk_cache.XXXXXX";
+  if (!mkdtemp(dir)) {
+    std::cerr << "mkdtemp failed\n";
+    return 1;
+  }
+
+  {
+    re::DiskCache cache(dir);
+    {
+      auto const m = cache.get("[a-z]+@[a-z]+");
+      CHECK(re::matches(m.ranges(), "ab@cd"));
+      CHECK(!re::matches(m.ranges(), "ab@"));
+    }
+    CHECK(cache.stats().misses == 1);
+    CHECK(cache.stats().hits == 0);
+    {
+      auto const m = cache.get("[a-z]+@[a-z]+");
+      CHECK(re::matches(m.ranges(), "ab@cd"));
+    }
+    CHECK(cache.stats().hits == 1);
+
+    // another instance reuses the files
+    re::DiskCache cache2(dir);
+    cache2.get("[a-z]+@[a-z]+");
+    CHECK(cache2.stats().hits == 1);
+    CHECK(cache2.stats().misses == 0);
+
+    // a corrupted file is rewritten
+    auto const file = cache.filename("a|b");
+    cache.get("a|b");
+    {
+      std::ofstream out(file, std::ios::binary | std::ios::in);
+      out.seekp(48);
+      out.put('\x7f');
+    }
+    {
+      auto const m = cache.get("a|b");
+      CHECK(re::matches(m.ranges(), "b"));
+      CHECK(!re::matches(m.ranges(), "c"));
+    }
+    CHECK(cache.stats().misses == 3);
+
+    // the options are part of the key
+    re::ScanOptions icase;
+    icase.ignore_case = true;
+    CHECK(cache.filename("a|b", icase) != file);
+    {
+      auto const m = cache.get("a|b", icase);
+      CHECK(re::matches(m.ranges(), "B"));
+    }
+    CHECK(!re::matches(cache.get("a|b").ranges(), "B"));
+    CHECK(re::matches(cache.get("a|b", icase).ranges(), "B"));
+    CHECK(cache.stats().misses == 4);
+
+    bool has_error = false;
+    try {
+      cache.get("a)");
+    }
+    catch (std::runtime_error const &) {
+      has_error = true;
+    }
+    CHECK(has_error);
+
+    std::remove(cache.filename("[a-z]+@[a-z]+").c_str());
+    std::remove(file.c_str());
+    std::remove(cache.filename("a|b", icase).c_str());
+  }
+  rmdir(dir);
+
+  if (count_test_failure) {
+    std::cerr << "error(s): " << count_test_failure << "\n";
+  }
+  return count_test_failure ? 1 : 0;
+}
@@ -0,0 +1,88 @@
+#include "falcon/regex_dfa/factorize.hpp"
+#include "falcon/regex_dfa/scan.hpp"
+#include "falcon/regex_dfa/match.hpp"
+#include "falcon/regex_dfa/generate.hpp"
+#include "falcon/regex_dfa/print_automaton.hpp"
+
+#include <iostream>
+
+unsigned count_test_failure = 0;
+
+namespace re = falcon::regex_dfa;
+
+/// size of the factorized automaton and same results as the automaton
+/// of scan() on strings generated from both
+void test(char const * pattern, std::size_t size, bool is_deterministic, unsigned line)
+{
+  auto const rngs = re::scan(pattern);
+  auto factorized = rngs;
+  re::factorize(factorized);
+
+  auto report = [&](char const * s) {
+    std::cerr
+      << ++count_test_failure << "  line: " << line
+      << "\n pattern: " << pattern
+      << "\n size: " << factorized.size() << " expected: " << size
+      << "\n deterministic: " << factorized.is_deterministic
+      << "\n str: " << s << "\n\n";
+    re::print_automaton(factorized);
+    std::cerr << "----------\n";
+  };
+
+  if (factorized.size() != size || factorized.is_deterministic != is_deterministic) {
+    report("");
+    return;
+  }
+
+  std::string s;
+  re::Ranges const * const sources[] {&rngs, &factorized};
+  for (auto from : sources) {
+    re::Generator generator(*from, line);
+    for (std::size_t length : {0, 1, 3, 8, 20}) {
+      for (int i = 0; i < 10; ++i) {
+        for (int mode = 0; mode < 3; ++mode) {
+          if (mode == 0) {
+            generator.matching(s, length);
+          }
+          else if (mode == 1) {
+            generator.near_miss(s, length);
+          }
+          else {
+            generator.adversarial(s, length);
+          }
+          if (re::matches(rngs, s.c_str()) != re::matches(factorized, s.c_str())
+           || re::nfa_match(rngs, s.c_str()) != re::nfa_match(factorized, s.c_str())
+          ) {
+            report(s.c_str());
+            return;
+          }
+        }
+      }
+    }
+  }
+}
+
+#define TEST(pattern, size, is_deterministic) \
+  test(pattern, size, is_deterministic, __LINE__)
+
+int main() {
+  TEST("abc", 4, true);
+  TEST("ab|ac", 3, true);
+  TEST("ab|cb", 3, true);
+  TEST("foobar|foobaz|fooqux", 9, true);
+  TEST("GET|GETS|POST|PUT", 8, true);
+  // the end of GET closes the capture, not the T of GETS
+  TEST("(GET|GETS|POST|PUT)", 8, false);
+  TEST("x(ab|ac)*y", 6, false);
+  TEST("(a|ab)(c|bcd)", 6, false);
+  TEST("a+b|a+c", 4, false);
+  TEST("[a-c]*a[a-c]{3}", 6, false);
+  TEST("\"[^\"]*\"", 3, true);
+  TEST("^a|b$", 2, true);
+  TEST("", 1, true);
+
+  if (count_test_failure) {
+    std::cerr << "error(s): " << count_test_failure << "\n";
+  }
+  return count_test_failure ? 1 : 0;
+}
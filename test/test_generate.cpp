@@ -0,0 +1,98 @@
+#include "falcon/regex_dfa/generate.hpp"
+#include "falcon/regex_dfa/scan.hpp"
+#include "falcon/regex_dfa/match.hpp"
+#include "check.hpp"
+
+#include <iostream>
+
+unsigned count_test_failure = 0;
+
+namespace re = falcon::regex_dfa;
+
+/// generated strings against nfa_match() and match()
+void test(char const * pattern, bool has_near_miss, unsigned line)
+{
+  auto const rngs = re::scan(pattern);
+  re::Generator generator(rngs, line);
+  std::string s;
+  for (std::size_t length : {0, 1, 5, 40}) {
+    for (int i = 0; i < 20; ++i) {
+      bool const ok = generator.matching(s, length)
+        && re::nfa_match(rngs, s.c_str())
+        && re::matches(rngs, s.c_str());
+      if (!ok || (has_near_miss
+        && (!generator.near_miss(s, length) || re::nfa_match(rngs, s.c_str())))
+      ) {
+        std::cerr
+          << ++count_test_failure << "  line: " << line
+          << "\n pattern: " << pattern << "\n str: " << s << "\n----------\n";
+        return;
+      }
+    }
+  }
+}
+
+#define TEST(pattern) test(pattern, true, __LINE__)
+#define TEST_NO_MISS(pattern) test(pattern, false, __LINE__)
+
+int main() {
+  TEST("a");
+  TEST("abc");
+  TEST("a*");
+  TEST("[a-z]+@[a-z]+");
+  TEST("(ab|cd)*e");
+  TEST("[0-9]{2}-[0-9]+");
+  TEST("\"[^\"]*\"");
+  TEST("[éê]+a");
+  TEST("^(a|b)|c$");
+  TEST("[^a]");
+  TEST("[a-c]*a[a-c]{3}");
+  TEST_NO_MISS(".*");
+
+  // same seed, same strings
+  {
+    auto const rngs = re::scan("[a-z]{3}[0-9]*");
+    re::Generator g1(rngs, 42);
+    re::Generator g2(rngs, 42);
+    std::string s1;
+    std::string s2;
+    for (int i = 0; i < 10; ++i) {
+      g1.matching(s1, 10);
+      g2.matching(s2, 10);
+      CHECK(s1 == s2);
+      CHECK(s1.size() == 10);
+    }
+  }
+
+  // no string
+  {
+    auto const rngs = re::scan("a^b");
+    re::Generator generator(rngs, 0);
+    std::string s;
+    CHECK(!generator.matching(s, 3));
+  }
+
+  // the active set stays large
+  {
+    auto const rngs = re::scan("[a-c]*a[a-c]{3}");
+    re::Generator generator(rngs, 0);
+    std::string s;
+    generator.adversarial(s, 50);
+    CHECK(s.size() == 50);
+    CHECK(s.find_first_not_of("a") == std::string::npos);
+  }
+
+  {
+    std::string s;
+    CHECK(re::append_utf8(s, 'a'));
+    CHECK(re::append_utf8(s, 0xC3A9));
+    CHECK(!re::append_utf8(s, 0x80));
+    CHECK(!re::append_utf8(s, 0));
+    CHECK(s == "aé");
+  }
+
+  if (count_test_failure) {
+    std::cerr << "error(s): " << count_test_failure << "\n";
+  }
+  return count_test_failure ? 1 : 0;
+}
@@ -0,0 +1,68 @@
+#include "falcon/regex_dfa/heatmap.hpp"
+#include "falcon/regex_dfa/scan.hpp"
+#include "falcon/regex_dfa/match.hpp"
+#include "falcon/regex_dfa/print_automaton.hpp"
+#include "check.hpp"
+
+#include <iostream>
+#include <sstream>
+
+unsigned count_test_failure = 0;
+
+namespace re = falcon::regex_dfa;
+
+using counters = std::vector<uint64_t>;
+
+int main() {
+  // deterministic
+  {
+    auto const rngs = re::scan("a(b|c)");
+    re::Heatmap heatmap;
+    CHECK(re::profile_matches(rngs, "ab", heatmap));
+    CHECK(!re::profile_matches(rngs, "cb", heatmap));
+    CHECK(heatmap.entered.size() == rngs.size());
+    CHECK(heatmap.entered[0] == 2);
+    uint64_t entered = 0;
+    for (auto n : heatmap.entered) {
+      entered += n;
+    }
+    // 2 starts, a, b
+    CHECK(entered == 4);
+    CHECK(heatmap.tested[0] >= 2);
+  }
+
+  // non deterministic, same results as matches()
+  {
+    auto const rngs = re::scan("(a|a(b))(c|bcd)");
+    re::Heatmap heatmap;
+    for (auto s : {"abcd", "abc", "ac", "abd"}) {
+      CHECK(re::profile_matches(rngs, s, heatmap) == re::matches(rngs, s));
+    }
+    CHECK(heatmap.entered[0] == 4);
+  }
+
+  // Graphviz
+  {
+    auto const rngs = re::scan("a[0-9\"]");
+    re::Heatmap heatmap;
+    re::profile_matches(rngs, "a1", heatmap);
+    std::ostringstream out;
+    re::print_dot(out, rngs, &heatmap);
+    auto const dot = out.str();
+    CHECK(dot.compare(0, 18, "digraph regex_dfa ") == 0);
+    CHECK(dot.find("0 -> 1 [label=\"a\"]") != std::string::npos);
+    CHECK(dot.find("\\\"") != std::string::npos);
+    CHECK(dot.find("0-9") != std::string::npos);
+    CHECK(dot.find("fillcolor=\"0.000 1.000 1.000\"") != std::string::npos);
+    CHECK(dot.find("doublecircle") != std::string::npos);
+
+    std::ostringstream out2;
+    re::print_dot(out2, rngs);
+    CHECK(out2.str().find("entered") == std::string::npos);
+  }
+
+  if (count_test_failure) {
+    std::cerr << "error(s): " << count_test_failure << "\n";
+  }
+  return count_test_failure ? 1 : 0;
+}
@@ -0,0 +1,87 @@
+#include "falcon/regex_dfa/jit.hpp"
+#include "falcon/regex_dfa/scan.hpp"
+#include "falcon/regex_dfa/match.hpp"
+#include "falcon/regex_dfa/decided_states.hpp"
+#include "falcon/regex_dfa/print_automaton.hpp"
+
+#include <iostream>
+
+unsigned count_test_failure = 0;
+
+namespace re = falcon::regex_dfa;
+
+void test(
+  char const * pattern
+, std::initializer_list<char const *> strings
+, unsigned line
+) {
+  re::Ranges const rngs = re::scan(pattern);
+  re::JitMatcher const jit(rngs);
+#if defined(__x86_64__) && defined(__linux__) && !defined(FALCON_REGEX_DFA_DISABLE_JIT)
+  if (jit.is_native() != rngs.is_deterministic) {
+    std::cerr
+      << ++count_test_failure << "  line: " << line
+      << "\n\n pattern: \033[37;02m" << pattern
+      << "\n\033[0m not compiled\n----------\n"
+    ;
+  }
+#endif
+  for (char const * s : strings) {
+    bool const is_ok = re::matches(rngs, s);
+    if (jit(s) != is_ok) {
+      std::cerr
+        << ++count_test_failure << "  line: " << line
+        << "\n\n pattern: \033[37;02m" << pattern
+        << "\n\033[0m str: \033[37;02m" << s
+        << "\n\033[0m expected match: " << is_ok
+        << "\n\n"
+      ;
+      re::print_automaton(rngs);
+      std::cerr << "----------\n";
+    }
+  }
+}
+
+#define TEST(pattern, ...) test(pattern, {__VA_ARGS__}, __LINE__)
+
+int main() {
+  TEST("", "", "a");
+  TEST("a", "", "a", "b", "aa");
+  TEST("^a$", "", "a", "b", "aa");
+  TEST("abc", "abc", "ab", "abcd", "abd");
+  TEST("a+", "a", "aaaa", "aab", "");
+  TEST("[a-z]+@[a-z]+", "a@b", "abc@def", "abc@", "@def", "abc@def@");
+  TEST("[0-9]{2}-[0-9]+", "12-3", "12-345", "12-", "1-34");
+  TEST("\"[^\"]*\"", "\"\"", "\"abé\"", "\"ab\"c\"", "\"ab");
+  TEST("a|b", "a", "b", "c", "ab");
+  TEST("[éê]+", "éê", "e", "éeê");
+  TEST("[^a]", "é", "a", "b", "bb");
+  TEST("(ab){2,4}", "ab", "abab", "ababab", "abababab", "ababababab");
+  TEST(".*a$", "a", "ba", "b", "");
+  TEST("ab|ac", "ab", "ac", "ad");
+  TEST(".*", "", "abc");
+  TEST("^GET .*", "GET /index.html", "GET ", "GET", "GE /");
+
+  // b|a followed by nothing final
+  {
+    re::Ranges dead(3);
+    dead[0].states = re::Range::Normal;
+    dead[0].transitions = {{{'a', 'a'}, 1, re::Transition::Normal}, {{'b', 'b'}, 2, re::Transition::Normal}};
+    dead[1].states = re::Range::Normal;
+    dead[1].transitions = {{{'x', 'x'}, 1, re::Transition::Normal}};
+    dead[2].states = re::Range::Final;
+    dead.is_deterministic = true;
+    re::mark_decided_states(dead);
+    re::JitMatcher const jit(dead);
+    for (char const * s : {"a", "axxx", "b", "bx"}) {
+      if (jit(s) != re::match(dead, s)) {
+        std::cerr << ++count_test_failure << "  line: " << __LINE__ << "\n str: " << s << "\n----------\n";
+      }
+    }
+  }
+
+  if (count_test_failure) {
+    std::cerr << "error(s): " << count_test_failure << "\n";
+  }
+  return count_test_failure ? 1 : 0;
+}
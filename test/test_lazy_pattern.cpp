@@ -0,0 +1,104 @@
+#include "falcon/regex_dfa/lazy_pattern.hpp"
+#include "falcon/regex_dfa/scan.hpp"
+#include "check.hpp"
+
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+unsigned count_test_failure = 0;
+
+namespace re = falcon::regex_dfa;
+
+int main() {
+  {
+    re::LazyPattern p("[a-z]+@[a-z]+");
+    CHECK(!p.is_compiled());
+    CHECK(p.pattern() == "[a-z]+@[a-z]+");
+    CHECK(p("abc@def"));
+    CHECK(p.is_compiled());
+    CHECK(!p("abc@"));
+    CHECK(p.ranges() == re::scan("[a-z]+@[a-z]+"));
+  }
+
+  {
+    re::ScanOptions icase;
+    icase.ignore_case = true;
+    re::LazyPattern p("[a-z]+@[a-z]+", icase);
+    CHECK(p.options().ignore_case);
+    CHECK(p("aBc@DeF"));
+    CHECK(p.ranges() == re::scan("[a-z]+@[a-z]+", icase));
+  }
+
+  // the error is kept
+  {
+    re::LazyPattern p("a)");
+    CHECK(!p.compile());
+    CHECK(p.is_compiled());
+    for (int i = 0; i < 2; ++i) {
+      bool has_error = false;
+      try {
+        p("a");
+      }
+      catch (std::runtime_error const &) {
+        has_error = true;
+      }
+      CHECK(has_error);
+    }
+  }
+
+  // concurrent first uses
+  {
+    re::LazyPattern p("(ab|cd)*e");
+    std::vector<std::thread> threads;
+    std::vector<re::Ranges const *> results(8);
+    for (std::size_t i = 0; i < results.size(); ++i) {
+      threads.emplace_back([&p, &results, i]{ results[i] = &p.ranges(); });
+    }
+    for (auto & thread : threads) {
+      thread.join();
+    }
+    for (auto rngs : results) {
+      CHECK(rngs == &p.ranges());
+    }
+  }
+
+  // background compilation
+  {
+    char const * patterns_str[] = {"a", "b+", "[0-9]{2}", "(", "x|y|z", ".*a$"};
+    std::vector<std::unique_ptr<re::LazyPattern>> patterns;
+    std::vector<re::LazyPattern const *> ptrs;
+    for (auto s : patterns_str) {
+      patterns.emplace_back(new re::LazyPattern(s));
+      ptrs.push_back(patterns.back().get());
+    }
+    CHECK((*patterns[1])("bb"));
+
+    re::BackgroundCompiler compiler(ptrs, 3);
+    compiler.wait();
+    CHECK(compiler.done());
+    for (std::size_t i = 0; i < patterns.size(); ++i) {
+      CHECK(patterns[i]->is_compiled());
+      CHECK(patterns[i]->compile() == (i != 3));
+    }
+    CHECK((*patterns[5])("bba"));
+
+    // concurrent wait()
+    {
+      re::BackgroundCompiler compiler3(ptrs, 2);
+      std::thread waiter([&compiler3]{ compiler3.wait(); });
+      compiler3.wait();
+      waiter.join();
+      CHECK(compiler3.done());
+    }
+
+    // destroyed without wait()
+    re::BackgroundCompiler compiler2(ptrs, 2);
+  }
+
+  if (count_test_failure) {
+    std::cerr << "error(s): " << count_test_failure << "\n";
+  }
+  return count_test_failure ? 1 : 0;
+}
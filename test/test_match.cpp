@@ -1,5 +1,6 @@
 #include "falcon/regex_dfa/scan.hpp"
 #include "falcon/regex_dfa/match.hpp"
+#include "falcon/regex_dfa/flat_ranges.hpp"
 #include "falcon/regex_dfa/print_automaton.hpp"
 
 #include <iostream>
@@ -8,6 +9,9 @@ unsigned count_test_failure = 0;
 
 namespace re = falcon::regex_dfa;
 
+re::Compiler compiler;
+re::FlatArena arena;
+
 void test(
   char const * pattern
 , char const * s
@@ -15,12 +19,66 @@ void test(
 , unsigned line
 ) {
   re::Ranges const & rngs = re::scan(pattern);
-  if (re::nfa_match(rngs, s) != is_ok) {
+  std::string const image = re::serialize(rngs);
+  re::FlatRanges const flat_rngs(image.data(), image.size());
+  re::FlatRanges const arena_rngs = compiler.scan(pattern, arena);
+  if (re::nfa_match(rngs, s) != is_ok
+   || re::matches(rngs, s) != is_ok
+   || re::matches(flat_rngs, s) != is_ok
+   || re::matches(arena_rngs, s) != is_ok
+  ) {
     std::cerr
       << ++count_test_failure << "  line: " << line
       << "\n\n pattern: \033[37;02m" << pattern
       << "\n\033[0m str: \033[37;02m" << s
       << "\n\033[0m expected match: " << is_ok
+      << "\n deterministic: " << rngs.is_deterministic
+      << "\n\n"
+    ;
+    re::print_automaton(rngs);
+    std::cerr << "----------\n";
+  }
+}
+
+void test_deterministic(
+  char const * pattern
+, bool is_deterministic
+, unsigned line
+) {
+  re::Ranges const & rngs = re::scan(pattern);
+  if (rngs.is_deterministic != is_deterministic) {
+    std::cerr
+      << ++count_test_failure << "  line: " << line
+      << "\n\n pattern: \033[37;02m" << pattern
+      << "\n\033[0m expected deterministic: " << is_deterministic
+      << "\n\n"
+    ;
+    re::print_automaton(rngs);
+    std::cerr << "----------\n";
+  }
+}
+
+/// with ScanOptions::ignore_case, the number of ranges is unchanged
+void test_ignore_case(
+  char const * pattern
+, char const * s
+, bool is_ok
+, unsigned line
+) {
+  re::ScanOptions options;
+  options.ignore_case = true;
+  re::Ranges const & rngs = re::scan(pattern, options);
+  re::FlatRanges const arena_rngs = compiler.scan(pattern, arena, options);
+  if (re::nfa_match(rngs, s) != is_ok
+   || re::matches(rngs, s) != is_ok
+   || re::matches(arena_rngs, s) != is_ok
+   || rngs.size() != re::scan(pattern).size()
+  ) {
+    std::cerr
+      << ++count_test_failure << "  line: " << line
+      << "\n\n pattern: \033[37;02m" << pattern
+      << "\n\033[0m str: \033[37;02m" << s
+      << "\n\033[0m expected match (ignore case): " << is_ok
       << "\n\n"
     ;
     re::print_automaton(rngs);
@@ -30,6 +88,10 @@ void test(
 
 #define YES(pattern, s) test(pattern, s, true, __LINE__)
 #define NO(pattern, s) test(pattern, s, false, __LINE__)
+#define ICASE_YES(pattern, s) test_ignore_case(pattern, s, true, __LINE__)
+#define ICASE_NO(pattern, s) test_ignore_case(pattern, s, false, __LINE__)
+#define DFA(pattern) test_deterministic(pattern, true, __LINE__)
+#define NFA(pattern) test_deterministic(pattern, false, __LINE__)
 
 int main() {
 
@@ -173,6 +235,24 @@ int main() {
   NO("^(a|b)|c$", "ua");
   NO("^(a|b)|c$", "d");
 
+  YES("ab|cd", "ab");
+  YES("ab|cd", "cd");
+  NO("ab|cd", "abcd");
+  NO("ab|cd", "a");
+  YES("ab|c", "ab");
+  NO("ab|c", "abc");
+  YES("abc|d|ab", "abc");
+  YES("abc|d|ab", "ab");
+  YES("x(ab|cd)y", "xaby");
+  YES("x(ab|cd)y", "xcdy");
+  NO("x(ab|cd)y", "xy");
+  YES("(ab|cd)+", "abcdab");
+  NO("(ab|cd)+", "abc");
+  YES("a(bc|d)*c", "adbcc");
+  YES("(GET|POST|PUT|DELETE)", "GET");
+  YES("(GET|POST|PUT|DELETE)", "DELETE");
+  NO("(GET|POST|PUT|DELETE)", "GETPUT");
+
   YES("(a)+", "a");
   YES("(a)+", "aa");
   YES("(a)+", "aaa");
@@ -389,6 +469,54 @@ int main() {
   NO("^(?!a+|b+|cd*){3}$", "cc");
   NO("^(?!a+|b+|cd*){3}$", "ab");
 
+  YES("[^\"]*\"", "abc\"");
+  YES("[^\"]*\"", "\"");
+  YES("[^\"]*\"", "é\"");
+  NO("[^\"]*\"", "abc");
+  NO("[^\"]*\"", "a\"b\"");
+  YES(".*foo", "barfoo");
+  YES(".*foo", "fofoo");
+  YES(".*foo", "ffoo");
+  NO(".*foo", "foob");
+  NO(".*foo", "fo");
+  YES("[ \t]*a", " \t a");
+  NO("[ \t]*a", " \t b");
+  YES("^a.*", "abcdé");
+  NO("^a.*", "babcd");
+
+  NO("error", "ERROR");
+  ICASE_YES("error", "ERROR");
+  ICASE_YES("error", "eRrOr");
+  ICASE_NO("error", "errors");
+  ICASE_YES("[a-c]+x", "aBcX");
+  ICASE_NO("[a-c]+x", "aBdX");
+  ICASE_YES("[^a]", "b");
+  ICASE_NO("[^a]", "A");
+  ICASE_YES("k", "\u212a");
+  ICASE_YES("K", "\u212a");
+  ICASE_YES("[k-k]", "K");
+  ICASE_YES("s", "\u017f");
+  ICASE_YES("é", "É");
+  ICASE_YES("\u03c3+", "\u03a3\u03c2\u03c3");
+  ICASE_YES("\u0100\u0101", "\u0101\u0100");
+  ICASE_YES("\u0434", "\u0414");
+  ICASE_NO("i", "\u0131");
+  ICASE_YES("^GET .*", "get /");
+  ICASE_YES("a\\.b", "A.B");
+  ICASE_NO("a\\.b", "AxB");
+  ICASE_YES("1-2", "1-2");
+
+  DFA("");
+  DFA("a");
+  DFA("^a$");
+  DFA("abc");
+  DFA("a+");
+  DFA("[a-z]+@[a-z]+");
+  DFA("a|b");
+  NFA(".*a$");
+  NFA("a*a");
+  NFA("ab|ac");
+
   if (count_test_failure) {
     std::cerr << "error(s): " << count_test_failure << "\n";
   }
@@ -0,0 +1,102 @@
+#include "falcon/regex_dfa/pattern_cache.hpp"
+#include "falcon/regex_dfa/scan.hpp"
+#include "check.hpp"
+
+#include <iostream>
+#include <thread>
+#include <vector>
+
+unsigned count_test_failure = 0;
+
+namespace re = falcon::regex_dfa;
+
+int main() {
+  {
+    re::PatternCache cache(1 << 20);
+    auto p1 = cache.get("[a-z]+@[a-z]+");
+    auto p2 = cache.get("[a-z]+@[a-z]+");
+    auto p3 = cache.get("a|b");
+    CHECK(p1 == p2);
+    CHECK(!(p1 == p3));
+    CHECK(*p1 == re::scan("[a-z]+@[a-z]+"));
+    CHECK(cache.size() == 2);
+    CHECK(cache.stats().hits == 1);
+    CHECK(cache.stats().misses == 2);
+    CHECK(cache.stats().evictions == 0);
+
+    bool has_error = false;
+    try {
+      cache.get("a)");
+    }
+    catch (std::runtime_error const &) {
+      has_error = true;
+    }
+    CHECK(has_error);
+    CHECK(cache.size() == 2);
+
+    cache.clear();
+    CHECK(cache.size() == 0);
+    CHECK(cache.bytes() == 0);
+    // still usable after clear
+    CHECK(*cache.get("a|b") == *p3);
+
+    // the options are part of the key
+    re::ScanOptions icase;
+    icase.ignore_case = true;
+    auto p4 = cache.get("a|b", icase);
+    CHECK(!(p4 == cache.get("a|b")));
+    CHECK(p4 == cache.get("a|b", icase));
+    CHECK(*p4 == re::scan("a|b", icase));
+    CHECK(!(*p4 == *p3));
+  }
+
+  // eviction by size, a pattern hit since the last eviction is kept
+  {
+    // pattern and options_bits()
+    auto const bytes = re::memory_size(re::scan("abc")) + 3 + 1;
+    re::PatternCache cache(bytes * 2, 1);
+    auto abc = cache.get("abc");
+    cache.get("abd");
+    cache.get("abc");
+    cache.get("abe");
+    CHECK(cache.size() == 2);
+    CHECK(cache.stats().evictions == 1);
+    CHECK(cache.bytes() <= bytes * 2);
+    CHECK(cache.get("abc") == abc);
+    CHECK(cache.stats().hits == 2);
+
+    // the inserted pattern is kept even when all the others were hit
+    cache.get("abc");
+    cache.get("abe");
+    auto abf = cache.get("abf");
+    CHECK(cache.size() == 2);
+    CHECK(cache.stats().evictions == 2);
+    CHECK(cache.get("abf") == abf);
+  }
+
+  // concurrent accesses
+  {
+    re::PatternCache cache(1 << 20, 4);
+    char const * patterns[]{"a+", "b*c", "[0-9]{2}", "(ab|cd)+", "x"};
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; ++i) {
+      threads.emplace_back([&]{
+        for (int n = 0; n < 1000; ++n) {
+          cache.get(patterns[n % 5]);
+        }
+      });
+    }
+    for (auto & th : threads) {
+      th.join();
+    }
+    auto const stats = cache.stats();
+    CHECK(cache.size() == 5);
+    CHECK(stats.hits + stats.misses == 8000);
+    CHECK(cache.get("a+") == cache.get("a+"));
+  }
+
+  if (count_test_failure) {
+    std::cerr << "error(s): " << count_test_failure << "\n";
+  }
+  return count_test_failure ? 1 : 0;
+}
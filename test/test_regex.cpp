@@ -0,0 +1,79 @@
+#include "falcon/regex_dfa/regex.hpp"
+#include "falcon/regex_dfa/scan.hpp"
+#include "falcon/regex_dfa/match.hpp"
+#include "falcon/regex_dfa/generate.hpp"
+
+#include <iostream>
+#include <cstring>
+
+unsigned count_test_failure = 0;
+
+namespace re = falcon::regex_dfa;
+
+/// engine and same results as matches() on generated strings
+void test(char const * pattern, re::Regex::Engine engine, unsigned line)
+{
+  re::Regex const regex(pattern);
+  auto const & rngs = regex.ranges();
+  auto report = [&](char const * s) {
+    std::cerr
+      << ++count_test_failure << "  line: " << line
+      << "\n pattern: " << pattern
+      << "\n engine: " << re::to_string(regex.engine())
+      << "\n expected engine: " << re::to_string(engine)
+      << "\n str: " << s << "\n----------\n";
+  };
+
+  if (regex.engine() != engine) {
+    report("");
+    return;
+  }
+
+  re::Generator generator(rngs, line);
+  std::string s;
+  for (std::size_t length : {0, 1, 3, 10, 80}) {
+    for (int i = 0; i < 10; ++i) {
+      for (int mode = 0; mode < 3; ++mode) {
+        if (mode == 0) {
+          generator.matching(s, length);
+        }
+        else if (mode == 1) {
+          generator.near_miss(s, length);
+        }
+        else {
+          generator.adversarial(s, length);
+        }
+        auto const expected = re::matches(rngs, s.c_str());
+        if (regex(s.c_str()) != expected || regex(s) != expected) {
+          report(s.c_str());
+          return;
+        }
+      }
+    }
+  }
+}
+
+#define TEST(pattern, engine) test(pattern, re::Regex::Engine::engine, __LINE__)
+
+int main() {
+  TEST("GET /index\\.html", Literal);
+  TEST("GET /index.html", Dfa);
+  TEST("^/healthz$", Literal);
+  TEST("", Literal);
+  TEST("(GET|POST|PUT|DELETE)", LiteralSet);
+  TEST("[Gg]et|[Pp]ut /", LiteralSet);
+  TEST("a?b?c?", LiteralSet);
+  TEST("^(ab|é|€)$", LiteralSet);
+  TEST("[a-z]+@[a-z]+", Dfa);
+  TEST("\"[^\"]*\"", Dfa);
+  TEST("(a|b)*a(a|b)", BitParallel);
+  TEST("[a-c]*a[a-c]{3}", BitParallel);
+  TEST("^(?!a+|b+|cd*){3}$", BitParallel);
+  TEST("[éê]*é.", BitParallel);
+  TEST("[a-c]*a[a-c]{70}", Nfa);
+
+  if (count_test_failure) {
+    std::cerr << "error(s): " << count_test_failure << "\n";
+  }
+  return count_test_failure ? 1 : 0;
+}
@@ -0,0 +1,96 @@
+#include "falcon/regex_dfa/reverse.hpp"
+#include "falcon/regex_dfa/scan.hpp"
+#include "falcon/regex_dfa/match.hpp"
+#include "falcon/regex_dfa/generate.hpp"
+#include "falcon/regex_dfa/print_automaton.hpp"
+
+#include <iostream>
+
+unsigned count_test_failure = 0;
+
+namespace re = falcon::regex_dfa;
+
+/// characters of s in the reverse order
+std::string reversed_string(std::string const & s)
+{
+  std::string r;
+  re::utf8_consumer consumer(s.c_str());
+  char const * p = consumer.str();
+  while (consumer.bumpc()) {
+    r.insert(0, p, static_cast<std::size_t>(consumer.str() - p));
+    p = consumer.str();
+  }
+  return r;
+}
+
+/// same results as the automaton of scan() on the reversed strings
+/// generated from both
+void test(char const * pattern, unsigned line)
+{
+  auto const rngs = re::scan(pattern);
+  auto const reversed = re::reverse(rngs);
+
+  auto report = [&](char const * s) {
+    std::cerr
+      << ++count_test_failure << "  line: " << line
+      << "\n pattern: " << pattern
+      << "\n str: " << s << "\n\n";
+    re::print_automaton(reversed);
+    std::cerr << "----------\n";
+  };
+
+  std::string s;
+  std::string r;
+  for (int from = 0; from < 2; ++from) {
+    re::Generator generator(from ? reversed : rngs, line);
+    for (std::size_t length : {0, 1, 3, 8, 20}) {
+      for (int i = 0; i < 10; ++i) {
+        for (int mode = 0; mode < 3; ++mode) {
+          if (mode == 0) {
+            generator.matching(s, length);
+          }
+          else if (mode == 1) {
+            generator.near_miss(s, length);
+          }
+          else {
+            generator.adversarial(s, length);
+          }
+          if (from) {
+            swap(s, r);
+            s = reversed_string(r);
+          }
+          else {
+            r = reversed_string(s);
+          }
+          if (re::matches(rngs, s.c_str()) != re::matches(reversed, r.c_str())) {
+            report(s.c_str());
+            return;
+          }
+        }
+      }
+    }
+  }
+}
+
+#define TEST(pattern) test(pattern, __LINE__)
+
+int main() {
+  TEST("abc");
+  TEST("ab|ac");
+  TEST("a+b|a+c");
+  TEST("(a|ab)(c|bcd)");
+  TEST("[a-c]*a[a-c]{3}");
+  TEST("x(ab|ac)*y");
+  TEST("é+[^a]");
+  TEST("^ab");
+  TEST("ab$");
+  TEST("^a|b");
+  TEST(".*\\.(jpg|png)$");
+  TEST("a*");
+  TEST("");
+
+  if (count_test_failure) {
+    std::cerr << "error(s): " << count_test_failure << "\n";
+  }
+  return count_test_failure ? 1 : 0;
+}
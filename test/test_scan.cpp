@@ -3,19 +3,30 @@
 
 #include <iostream>
 #include <algorithm>
+#include <stdexcept>
 // #include <cassert>
 
 unsigned count_test_failure = 0;
 
 namespace re = falcon::regex_dfa;
 
+/// shared between the tests to check the reuse of its memory
+re::Compiler compiler;
+
 void test(
   char const * pattern
 , re::Ranges const & rngs2
 , unsigned line
 ) {
   re::Ranges const & rngs1 = re::scan(pattern);
+  re::Ranges const & rngs3 = compiler.scan(pattern);
   if (![&]{
+    if (!std::equal(rngs1.begin(), rngs1.end(), rngs3.begin(), rngs3.end())
+     || rngs1.capture_table != rngs3.capture_table
+    ) {
+      std::cerr << "# different result with a Compiler\n";
+      return false;
+    }
     if (rngs1.size() != rngs2.size()) {
       std::cerr << "# different size\n";
       return false;
@@ -653,6 +664,11 @@ int main()
 
   TEST("a|b", rs(r(a2b2), none, rf));
   TEST("a|b?", rs(r(F, a2b2), none, rf));
+  // every range of an alternative goes to the end of the group, not only the first
+  TEST("ab|cd", rs(r(ts{ta1, t('c', 3)}), r(ts{tb4}), none, r(ts{t('d', 4)}), rf));
+  TEST("abc|d|ab", rs(
+    r(ts{ta1, t('d', 6), t('a', 5)}), r(ts{tb2}), r(ts{t('c', 6)}),
+    none, none, r(ts{t('b', 6)}), rf));
 
   auto const td5 = t('d', 5);
   auto const td6 = t('d', 6);
@@ -693,6 +709,15 @@ int main()
 
   TEST("^(?!a|b)", rs(r(a2Bb2B), none, rf));
 
+  // a failure doesn't break the compiler
+  try {
+    compiler.scan("(a");
+    std::cerr << ++count_test_failure << "  line: " << __LINE__ << "\n";
+  }
+  catch (std::runtime_error const &) {
+  }
+  TEST("a", rs(r(a1), rf));
+
   if (count_test_failure) {
     std::cerr << "error(s): " << count_test_failure << "\n";
   }
@@ -0,0 +1,277 @@
+#include "falcon/regex_dfa/search.hpp"
+#include "falcon/regex_dfa/reverse.hpp"
+#include "falcon/regex_dfa/regex.hpp"
+#include "falcon/regex_dfa/scan.hpp"
+#include "falcon/regex_dfa/match.hpp"
+#include "falcon/regex_dfa/generate.hpp"
+#include "falcon/regex_dfa/print_automaton.hpp"
+
+#include <iostream>
+#include <algorithm>
+#include <random>
+
+unsigned count_test_failure = 0;
+
+namespace re = falcon::regex_dfa;
+
+void report(char const * pattern, char const * s, bool is_ok, unsigned line)
+{
+  std::cerr
+    << ++count_test_failure << "  line: " << line
+    << "\n\n pattern: \033[37;02m" << pattern
+    << "\n\033[0m str: \033[37;02m" << s
+    << "\n\033[0m expected search: " << is_ok
+    << "\n\n"
+  ;
+  re::print_automaton(re::scan(pattern));
+  std::cerr << "----------\n";
+}
+
+void test(char const * pattern, char const * s, bool is_ok, unsigned line)
+{
+  if (re::search(re::scan(pattern), s) != is_ok
+   || re::Regex(pattern).search(s) != is_ok
+  ) {
+    report(pattern, s, is_ok, line);
+  }
+}
+
+/// without anchor, search() is true when a substring is accepted by matches()
+void test_substrings(char const * pattern, unsigned line)
+{
+  auto const rngs = re::scan(pattern);
+  re::Regex const regex(pattern);
+  re::Generator generator(rngs, line);
+  std::mt19937_64 gen(line);
+  char const noise[] = "ab-1 x";
+
+  auto is_boundary = [](std::string const & s, std::size_t i) {
+    return (static_cast<unsigned char>(s[i]) & 0xc0) != 0x80;
+  };
+
+  std::string s;
+  std::string sub;
+  for (std::size_t length : {0, 1, 3, 8}) {
+    for (int i = 0; i < 20; ++i) {
+      if (i % 2) {
+        generator.matching(s, length);
+      }
+      else {
+        generator.near_miss(s, length);
+      }
+      s.insert(0, 1, noise[gen() % (sizeof(noise) - 1)]);
+      s += noise[gen() % (sizeof(noise) - 1)];
+
+      // first substring to end, from its leftmost beginning
+      bool is_ok = false;
+      std::size_t first = 0;
+      std::size_t last = 0;
+      for (; last <= s.size() && !is_ok; ++last) {
+        for (first = 0; first <= last && !is_ok; ++first) {
+          if (is_boundary(s, first) && is_boundary(s, last)) {
+            sub.assign(s, first, last - first);
+            is_ok = re::matches(rngs, sub.c_str());
+          }
+        }
+      }
+      --first;
+      --last;
+
+      char const * match_first = nullptr;
+      char const * match_last = nullptr;
+      if (re::search(rngs, s.c_str()) != is_ok
+       || regex.search(s) != is_ok
+       || regex.search(s.c_str(), match_first, match_last) != is_ok
+       || (is_ok && (match_first != s.c_str() + first || match_last != s.c_str() + last))
+      ) {
+        report(pattern, s.c_str(), is_ok, line);
+        return;
+      }
+    }
+  }
+}
+
+/// [first, last) of Regex::search(), first is -1 without match
+void test_span(char const * pattern, char const * s, int first, int last, unsigned line)
+{
+  char const * match_first = nullptr;
+  char const * match_last = nullptr;
+  int found_first = -1;
+  int found_last = -1;
+  if (re::Regex(pattern).search(s, match_first, match_last)) {
+    found_first = static_cast<int>(match_first - s);
+    found_last = static_cast<int>(match_last - s);
+  }
+  if (found_first != first || found_last != last) {
+    std::cerr
+      << ++count_test_failure << "  line: " << line
+      << "\n\n pattern: \033[37;02m" << pattern
+      << "\n\033[0m str: \033[37;02m" << s
+      << "\n\033[0m span: " << found_first << ", " << found_last
+      << "\n expected: " << first << ", " << last
+      << "\n----------\n";
+  }
+}
+
+/// search_suffix() of reverse()
+void test_suffix(char const * pattern, char const * s, bool is_ok, unsigned line)
+{
+  if (re::search_suffix(re::reverse(re::scan(pattern)), s) != is_ok) {
+    report(pattern, s, is_ok, line);
+  }
+}
+
+void test_first_bytes(char const * pattern, char const * bytes, unsigned line)
+{
+  re::FirstBytes const first(re::scan(pattern));
+  std::string found;
+  for (unsigned c = 0; c < 256; ++c) {
+    if (first.contains(static_cast<unsigned char>(c))) {
+      found += static_cast<char>(c);
+    }
+  }
+  if (found != bytes) {
+    std::cerr
+      << ++count_test_failure << "  line: " << line
+      << "\n\n pattern: \033[37;02m" << pattern
+      << "\n\033[0m first bytes: \033[37;02m" << found
+      << "\n\033[0m expected: \033[37;02m" << bytes
+      << "\n\033[0m----------\n";
+  }
+}
+
+#define TEST(pattern, s, is_ok) test(pattern, s, is_ok, __LINE__)
+#define YES(pattern, s) TEST(pattern, s, true)
+#define NO(pattern, s) TEST(pattern, s, false)
+#define SUBSTRINGS(pattern) test_substrings(pattern, __LINE__)
+#define SPAN(pattern, s, first, last) test_span(pattern, s, first, last, __LINE__)
+#define SUFFIX(pattern, s, is_ok) test_suffix(pattern, s, is_ok, __LINE__)
+#define FIRST_BYTES(pattern, bytes) test_first_bytes(pattern, bytes, __LINE__)
+
+int main() {
+  FIRST_BYTES("[0-9]{3}-", "0123456789");
+  FIRST_BYTES("ab|cd", "ac");
+  FIRST_BYTES("é|b", "b\xc3");
+  FIRST_BYTES("^a|b", "b");
+
+  {
+    re::FirstBytes const first(re::scan("."));
+    if (first.size() != 256 - 1 - 64 || !first.contains(0xf0) || first.contains(0x80)) {
+      std::cerr << ++count_test_failure << "  line: " << __LINE__ << "\n\n";
+    }
+  }
+
+  // SSE2 intervals, strcspn() with at most 16 bytes, then the table lookup,
+  // at each alignment
+  for (char const * pattern : {"[xyz]", "[a-z]", ".", "[acegikmoqy]", "[acegikmoqsuwy0-9]"}) {
+    re::FirstBytes const first(re::scan(pattern));
+    char buffer[64];
+    for (std::size_t offset = 0; offset < 16; ++offset) {
+      for (std::size_t i = 0; i + offset + 2 < sizeof(buffer); ++i) {
+        char * s = buffer + offset;
+        std::fill(s, s + i, '\x80');
+        s[i] = 'y';
+        s[i + 1] = 0;
+        char const * found = first.find(s);
+        s[i] = 0;
+        if (found != s + i || first.find(s) != s + i) {
+          std::cerr << ++count_test_failure << "  line: " << __LINE__
+            << "\n\n pattern: " << pattern << "\n position: " << i
+            << "\n offset: " << offset << "\n\n";
+        }
+      }
+    }
+  }
+
+  YES("", "");
+  YES("", "abc");
+  YES("b", "abc");
+  YES("bc", "abc");
+  NO("bd", "abc");
+  NO("b", "");
+  YES("[0-9]{3}-", "tel: 012-345");
+  NO("[0-9]{3}-", "tel: 01-345");
+  YES("é", "café");
+  NO("é", "cafe");
+  YES("ab|cd", "xxcdxx");
+  NO("ab|cd", "xxcxdxx");
+  YES("a+b", "caaab");
+  NO("a+b", "caaac");
+  YES("aab", "aaab");
+
+  YES("^ab", "abc");
+  NO("^ab", "cab");
+  YES("ab$", "cab");
+  NO("ab$", "abc");
+  YES("^ab$", "ab");
+  NO("^ab$", "abab");
+  YES("^$", "");
+  NO("^$", "a");
+  YES("^a*$", "");
+  NO("^a*$", "b");
+  NO("^(a|)$", "bb");
+  YES("^a|b", "cb");
+  YES("^a|b", "ac");
+  NO("^a|b", "ca");
+  YES("x*$", "abc");
+  YES(".*\\.(jpg|png)$", "a.b.png");
+  YES(".*\\.(jpg|png)$", ".jpg");
+  NO(".*\\.(jpg|png)$", "a.png.gz");
+  NO(".*\\.(jpg|png)$", "png");
+  YES("[0-9]+$", "abc123");
+  NO("[0-9]+$", "123abc");
+  YES("^[a-c]+$", "abc");
+  NO("^[a-c]+$", "abcd");
+
+  SPAN("b", "abc", 1, 2);
+  SPAN("b", "ac", -1, -1);
+  SPAN("", "abc", 0, 0);
+  SPAN("a+b", "caaab", 1, 5);
+  SPAN("abcd|c", "abcd", 2, 3);
+  SPAN("[0-9]{3}-", "tel: 012-345", 5, 9);
+  SPAN("é+", "café", 3, 5);
+  SPAN("^ab|b", "abb", 0, 2);
+  SPAN("ab$", "abab", 2, 4);
+  SPAN(".*\\.(jpg|png)$", "a.b.png", 0, 7);
+
+  // LiteralSet::search(), the longest of the first literals to end
+  SPAN("abc|bcd|c", "xabcd", 1, 4);
+  SPAN("he|she|his|hers", "ushers", 1, 4);
+  SPAN("he|she|his|hers", "hishe", 0, 3);
+  SPAN("GET|POST|PUT", "a PUT", 2, 5);
+  SPAN("GET|POST|PUT", "PU GE", -1, -1);
+  SPAN("a?b?", "xy", 0, 0);
+  SPAN("é|€", "a€é", 1, 4);
+  SPAN("^(ab|cd)$", "ab", 0, 2);
+  SPAN("^(ab|cd)$", "xab", -1, -1);
+
+  // ^ allows the empty substring only at the beginning
+  SPAN("^$", "", 0, 0);
+  SPAN("^$", "a", -1, -1);
+  SPAN("^a*$", "b", -1, -1);
+  SPAN("^a*$", "aa", 0, 2);
+  SPAN("^(a|)$", "bb", -1, -1);
+  SUFFIX("^$", "", true);
+  SUFFIX("^$", "a", false);
+  SUFFIX("^a*$", "b", false);
+  SUFFIX("^a*$", "aa", true);
+  SUFFIX("^(a|)$", "bb", false);
+  SUFFIX("a*$", "b", true);
+  SUFFIX("ab$", "cab", true);
+
+  SUBSTRINGS("b");
+  SUBSTRINGS("ab|ba");
+  SUBSTRINGS("a+b");
+  SUBSTRINGS("(ab)*x");
+  SUBSTRINGS("[a-c]*a[a-c]{2}");
+  SUBSTRINGS("[^a]b");
+  SUBSTRINGS("é+|-1");
+  SUBSTRINGS("x?a");
+  SUBSTRINGS("ab|b|bab|aab");
+  SUBSTRINGS("(é|a)(b|-1)");
+
+  if (count_test_failure) {
+    std::cerr << "error(s): " << count_test_failure << "\n";
+  }
+  return count_test_failure ? 1 : 0;
+}
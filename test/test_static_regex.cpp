@@ -0,0 +1,78 @@
+#include "test_static_regex.hpp"
+#include "falcon/regex_dfa/scan.hpp"
+#include "falcon/regex_dfa/match.hpp"
+
+#include <iostream>
+
+unsigned count_test_failure = 0;
+
+namespace re = falcon::regex_dfa;
+
+static_assert(empty(""), "");
+static_assert(!empty("a"), "");
+static_assert(email("ab@cd"), "");
+static_assert(!email("ab@"), "");
+static_assert(suffix("bba"), "");
+static_assert(!suffix("ab"), "");
+static_assert(digits("12-345"), "");
+static_assert(!digits("12-"), "");
+static_assert(get("GET /"), "");
+static_assert(!get("PUT /"), "");
+static_assert(prefix("abxx"), "");
+
+template<class StaticRegex>
+void test(
+  StaticRegex const & static_rngs
+, char const * pattern
+, char const * s
+, unsigned line
+) {
+  bool const is_ok = re::matches(re::scan(pattern), s);
+  if (static_rngs(s) != is_ok) {
+    std::cerr
+      << ++count_test_failure << "  line: " << line
+      << "\n\n pattern: \033[37;02m" << pattern
+      << "\n\033[0m str: \033[37;02m" << s
+      << "\n\033[0m expected match: " << is_ok
+      << "\n----------\n"
+    ;
+  }
+}
+
+#define TEST(name, pattern, s) test(name, pattern, s, __LINE__)
+
+int main() {
+  TEST(empty, "^$", "");
+  TEST(empty, "^$", "a");
+
+  TEST(email, "[a-z]+@[a-z]+", "a@b");
+  TEST(email, "[a-z]+@[a-z]+", "abc@def");
+  TEST(email, "[a-z]+@[a-z]+", "abc@");
+  TEST(email, "[a-z]+@[a-z]+", "@def");
+  TEST(email, "[a-z]+@[a-z]+", "abc@def@");
+
+  TEST(suffix, ".*a$", "a");
+  TEST(suffix, ".*a$", "éa");
+  TEST(suffix, ".*a$", "aaab");
+  TEST(suffix, ".*a$", "");
+
+  TEST(digits, "[0-9]{2}-[0-9]+", "12-3");
+  TEST(digits, "[0-9]{2}-[0-9]+", "12-345");
+  TEST(digits, "[0-9]{2}-[0-9]+", "12-");
+  TEST(digits, "[0-9]{2}-[0-9]+", "1-34");
+
+  TEST(get, "^GET .*", "GET /index.html");
+  TEST(get, "^GET .*", "GET ");
+  TEST(get, "^GET .*", "GET");
+  TEST(get, "^GET .*", "GE /");
+
+  TEST(prefix, "(a|ab).*c?", "a");
+  TEST(prefix, "(a|ab).*c?", "abxxxx");
+  TEST(prefix, "(a|ab).*c?", "");
+  TEST(prefix, "(a|ab).*c?", "ba");
+
+  if (count_test_failure) {
+    std::cerr << "error(s): " << count_test_failure << "\n";
+  }
+  return count_test_failure ? 1 : 0;
+}
@@ -0,0 +1,101 @@
+#include "falcon/regex_dfa/stats.hpp"
+#include "falcon/regex_dfa/scan.hpp"
+#include "falcon/regex_dfa/match.hpp"
+#include "falcon/regex_dfa/decided_states.hpp"
+#include "falcon/regex_dfa/redfa.hpp"
+#include "check.hpp"
+
+#include <iostream>
+#include <thread>
+
+unsigned count_test_failure = 0;
+
+namespace re = falcon::regex_dfa;
+
+int main() {
+  auto const & stats = re::match_stats();
+  // test_stats_enabled is always built with the counters
+#if defined(FALCON_REGEX_DFA_ENABLE_STATS) && FALCON_REGEX_DFA_ENABLE_STATS != 0
+  CHECK(re::has_match_stats());
+#else
+  CHECK(!re::has_match_stats());
+#endif
+  auto const abc = re::scan("abc");
+  auto const a_ab = re::scan("a|ab");
+
+  // b|a followed by nothing final
+  re::Ranges dead(3);
+  dead[0].states = re::Range::Normal;
+  dead[0].transitions = {{{'a', 'a'}, 1, re::Transition::Normal}, {{'b', 'b'}, 2, re::Transition::Normal}};
+  dead[1].states = re::Range::Normal;
+  dead[1].transitions = {{{'x', 'x'}, 1, re::Transition::Normal}};
+  dead[2].states = re::Range::Final;
+  re::mark_decided_states(dead);
+  CHECK(dead[1].hints == re::Range::Dead);
+  CHECK(dead[0].hints == re::Range::NoHint);
+  CHECK(dead[2].hints == re::Range::NoHint);
+  CHECK(re::match(dead, "b"));
+  CHECK(re::nfa_match(dead, "b"));
+
+  re::reset_match_stats();
+  CHECK(re::match(abc, "abc"));
+  CHECK(!re::match(abc, "abxyz"));
+  CHECK(re::nfa_match(a_ab, "ab"));
+
+  if (re::has_match_stats()) {
+    CHECK(stats.calls == 3);
+    CHECK(stats.characters == 3 + 3 + 2);
+    CHECK(stats.states_entered == 3 + 2 + 3);
+    CHECK(stats.transitions_examined >= stats.states_entered);
+    CHECK(stats.peak_active_states == 2);
+    CHECK(stats.early_exits == 1);
+
+    // accept-all
+    re::reset_match_stats();
+    CHECK(re::match(re::scan("^GET .*"), "GET /index.html HTTP/1.1"));
+    CHECK(stats.characters == 4);
+    CHECK(stats.early_accepts == 1);
+    CHECK(re::nfa_match(re::scan("(a|ab).*c?"), "abxxxxxxxx"));
+    CHECK(stats.characters == 4 + 1);
+    CHECK(stats.early_accepts == 2);
+    CHECK(re::match(re::scan("^GET .*"), "GET "));
+    CHECK(stats.early_accepts == 2);
+
+    // dead
+    re::reset_match_stats();
+    CHECK(!re::match(dead, "axxxx"));
+    CHECK(!re::nfa_match(dead, "axxxx"));
+    CHECK(stats.characters == 2);
+    CHECK(stats.early_exits == 2);
+
+    // skip
+    re::reset_match_stats();
+    CHECK(re::matches(re::scan("\"[^\"]*\""), "\"xxxxx\""));
+    CHECK(stats.skipped_bytes == 4);
+
+    // by thread
+    std::thread([]{
+      CHECK(re::match_stats().calls == 0);
+      re::match(re::scan("a"), "a");
+      CHECK(re::match_stats().calls == 1);
+    }).join();
+    CHECK(stats.calls == 1);
+  }
+  else {
+    // compiled out
+    CHECK(stats.calls == 0);
+    CHECK(stats.characters == 0);
+    CHECK(stats.states_entered == 0);
+    CHECK(stats.transitions_examined == 0);
+    CHECK(stats.peak_active_states == 0);
+    CHECK(stats.early_exits == 0);
+  }
+
+  re::reset_match_stats();
+  CHECK(stats.calls == 0);
+
+  if (count_test_failure) {
+    std::cerr << "error(s): " << count_test_failure << "\n";
+  }
+  return count_test_failure ? 1 : 0;
+}
@@ -0,0 +1,35 @@
+#include "falcon/regex_dfa/codegen.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+
+namespace re = falcon::regex_dfa;
+
+int main(int ac, char ** av) {
+  if (ac < 4 || ac % 2) {
+    std::cerr << "usage: " << av[0] << " file name pattern [name pattern...]\n";
+    return 1;
+  }
+
+  std::vector<char const *> names;
+  std::vector<char const *> patterns;
+  for (char ** p = av + 2; *p; p += 2) {
+    names.push_back(p[0]);
+    patterns.push_back(p[1]);
+  }
+
+  try {
+    std::ofstream out(av[1]);
+    re::write_matchers(out, names.data(), patterns.data(), names.size());
+    if (!out.flush()) {
+      std::cerr << "cannot write " << av[1] << "\n";
+      return 1;
+    }
+  }
+  catch (std::exception const & e) {
+    std::cerr << e.what() << "\n";
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,54 @@
+#include "falcon/regex_dfa/scan.hpp"
+#include "falcon/regex_dfa/generate.hpp"
+
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+
+namespace re = falcon::regex_dfa;
+
+int main(int ac, char ** av) {
+  uint64_t seed = 0;
+  std::size_t count = 10;
+  std::size_t length = 16;
+  char const * mode = "match";
+
+  int i = 1;
+  for (; i + 1 < ac && av[i][0] == '-'; i += 2) {
+    if (!std::strcmp(av[i], "-s")) seed = std::strtoull(av[i+1], nullptr, 10);
+    else if (!std::strcmp(av[i], "-n")) count = std::strtoull(av[i+1], nullptr, 10);
+    else if (!std::strcmp(av[i], "-l")) length = std::strtoull(av[i+1], nullptr, 10);
+    else if (!std::strcmp(av[i], "-m")) mode = av[i+1];
+    else break;
+  }
+
+  if (i + 1 != ac
+   || (std::strcmp(mode, "match") && std::strcmp(mode, "miss") && std::strcmp(mode, "adversarial"))
+  ) {
+    std::cerr
+      << "usage: " << av[0]
+      << " [-s seed] [-n count] [-l length] [-m match|miss|adversarial] pattern\n";
+    return 1;
+  }
+
+  try {
+    auto const rngs = re::scan(av[i]);
+    re::Generator generator(rngs, seed);
+    std::string s;
+    for (std::size_t n = 0; n < count; ++n) {
+      if (mode[0] == 'a') {
+        generator.adversarial(s, length);
+      }
+      else if (!(mode[1] == 'a' ? generator.matching(s, length) : generator.near_miss(s, length))) {
+        std::cerr << "no " << mode << " string\n";
+        return 2;
+      }
+      std::cout << s << "\n";
+    }
+  }
+  catch (std::exception const & e) {
+    std::cerr << e.what() << "\n";
+    return 1;
+  }
+  return 0;
+}
@@ -1,19 +1,70 @@
 #include "falcon/regex_dfa/scan.hpp"
 #include "falcon/regex_dfa/match.hpp"
+#include "falcon/regex_dfa/flat_ranges.hpp"
 #include "falcon/regex_dfa/print_automaton.hpp"
+#include "falcon/regex_dfa/heatmap.hpp"
+#include "falcon/regex_dfa/regex.hpp"
 
 #include <iostream>
+#include <cstring>
+#include <string>
 
 namespace re = falcon::regex_dfa;
 
 int main(int, char ** av) {
-  if (av[1]) {
+  // -i file strings...: match with a binary image created by re_scan -o
+  if (av[1] && !std::strcmp(av[1], "-i") && av[2]) {
+    re::MappedRanges const image(av[2]);
+    char ** arr_str = av + 2;
+    while (*++arr_str) {
+      std::cout << "match: " << re::matches(image.ranges(), *arr_str) << " -- " << *arr_str << "\n";
+    }
+  }
+  // -p pattern strings...: automaton with the visits of the ranges
+  // -d pattern strings...: same in Graphviz format
+  else if (av[1] && (!std::strcmp(av[1], "-p") || !std::strcmp(av[1], "-d")) && av[2]) {
+    auto const rngs = re::scan(av[2]);
+    re::Heatmap heatmap;
+    char ** arr_str = av + 2;
+    while (*++arr_str) {
+      re::profile_matches(rngs, *arr_str, heatmap);
+    }
+    if (av[1][1] == 'd') {
+      re::print_dot(std::cout, rngs, &heatmap);
+    }
+    else {
+      re::print_automaton(rngs, heatmap);
+    }
+  }
+  // -a pattern strings...: analysis and matcher of Regex
+  else if (av[1] && !std::strcmp(av[1], "-a") && av[2]) {
+    re::Regex const regex(av[2]);
+    auto const & a = regex.analysis();
+    auto length = [](std::size_t n) {
+      return n == re::infinite_length ? std::string("inf") : std::to_string(n);
+    };
+    std::cout
+      << "states: " << a.nb_states
+      << "\ntransitions: " << a.nb_transitions
+      << "\ndeterministic: " << a.is_deterministic
+      << "\nanchored: " << a.is_anchored_begin << " " << a.is_anchored_end
+      << "\nliteral: " << a.is_literal << (a.is_literal ? " " + a.literal : "")
+      << "\nlength: " << length(a.min_length) << " " << length(a.max_length)
+      << "\nbytes: " << length(a.min_bytes) << " " << length(a.max_bytes)
+      << "\nengine: " << re::to_string(regex.engine())
+      << "\n";
+    char ** arr_str = av + 2;
+    while (*++arr_str) {
+      std::cout << "match: " << regex(*arr_str) << " -- " << *arr_str << "\n";
+    }
+  }
+  else if (av[1]) {
     char ** arr_str = av;
     std::cout << "pattern: \033[37;02m" << *arr_str << "\033[0m\n";
     auto const rngs = re::scan(*arr_str);
     re::print_automaton(rngs);
     while (*++arr_str) {
-      std::cout << "match: " << re::nfa_match(rngs, *arr_str) << " -- " << *arr_str << "\n";
+      std::cout << "match: " << re::matches(rngs, *arr_str) << " -- " << *arr_str << "\n";
     }
   }
   else {
@@ -33,7 +84,7 @@ int main(int, char ** av) {
           std::cout << "\033[0m", 
           std::cin
         ) {
-          std::cout << "match: " << re::nfa_match(rngs, s.c_str()) << "\n";
+          std::cout << "match: " << re::matches(rngs, s.c_str()) << "\n";
         }
         std::cin.clear();
         std::cout << "\n";
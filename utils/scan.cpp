@@ -1,14 +1,73 @@
 #include "falcon/regex_dfa/scan.hpp"
+#include "falcon/regex_dfa/factorize.hpp"
+#include "falcon/regex_dfa/redfa.hpp"
+#include "falcon/regex_dfa/flat_ranges.hpp"
+#include "falcon/regex_dfa/static_regex.hpp"
 #include "falcon/regex_dfa/print_automaton.hpp"
 
 #include <iostream>
+#include <fstream>
+#include <vector>
+#include <cstring>
 
 namespace re = falcon::regex_dfa;
 
-int main(int, char ** av) {
-  if (av[1]) {
+int main(int ac, char ** av) {
+  // --cpp file name pattern [name pattern...]: write a header of static_regex
+  if (av[1] && !std::strcmp(av[1], "--cpp")) {
+    if (ac < 5 || ac % 2 == 0) {
+      std::cerr << "usage: --cpp file name pattern [name pattern...]\n";
+      return 1;
+    }
+    std::vector<char const *> names;
+    std::vector<char const *> patterns;
+    for (char ** p = av + 3; *p; p += 2) {
+      names.push_back(p[0]);
+      patterns.push_back(p[1]);
+    }
+    std::ofstream out(av[2]);
+    re::write_static_regex(out, names.data(), patterns.data(), names.size());
+    if (!out.flush()) {
+      std::cerr << "cannot write " << av[2] << "\n";
+      return 1;
+    }
+  }
+  else if (av[1]) {
     char ** arr_str = av;
     while (*++arr_str) {
+      // -o file pattern: write the binary image of pattern in file
+      if (!std::strcmp(*arr_str, "-o")) {
+        if (!arr_str[1] || !arr_str[2]) {
+          std::cerr << "usage: -o file pattern\n";
+          return 1;
+        }
+        char const * filename = *++arr_str;
+        std::ofstream out(filename, std::ios::binary);
+        re::serialize(out, re::scan(*++arr_str));
+        if (!out.flush()) {
+          std::cerr << "cannot write " << filename << "\n";
+          return 1;
+        }
+        continue;
+      }
+      // -i pattern: case insensitive automaton
+      if (!std::strcmp(*arr_str, "-i") && arr_str[1]) {
+        ++arr_str;
+        std::cout << "pattern: \033[37;02m" << *arr_str << "\033[0m (ignore case)\n";
+        re::ScanOptions options;
+        options.ignore_case = true;
+        re::print_automaton(re::scan(*arr_str, options));
+        continue;
+      }
+      // -f pattern: factorized automaton
+      if (!std::strcmp(*arr_str, "-f") && arr_str[1]) {
+        ++arr_str;
+        std::cout << "pattern: \033[37;02m" << *arr_str << "\033[0m (factorized)\n";
+        re::Ranges rngs = re::scan(*arr_str);
+        re::factorize(rngs);
+        re::print_automaton(rngs);
+        continue;
+      }
       std::cout << "pattern: \033[37;02m" << *arr_str << "\033[0m\n";
       re::print_automaton(re::scan(*arr_str));
     }